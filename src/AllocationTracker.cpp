@@ -0,0 +1,278 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Contains the source code for the allocation accounting classes and the global allocation hooks, which are
+ * only built with PARSER_TRACK_ALLOCATIONS
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+#include "AllocationTracker.h"
+
+using namespace std;
+
+/// The ledger charged by allocations on this thread, null when not counting
+static thread_local AllocationLedger *activeLedger = nullptr;
+/// The phase charged by allocations on this thread
+static thread_local AllocationPhase activePhase = PARSE_PHASE;
+/// The serial number of the most recently created ledger
+static atomic<unsigned long long> lastSerial(0);
+
+#ifdef PARSER_TRACK_ALLOCATIONS
+
+/**
+ * @brief Who was charged for a block.
+ */
+struct BlockOwner
+{
+    /// The serial number of the ledger charged for the block, 0 if none was
+    unsigned long long ledger;
+    /// The phase charged for the block
+    AllocationPhase phase;
+};
+
+/**
+ * @brief Written in front of every block operator new hands out, recording who to credit when it is freed.
+ */
+union BlockHeader
+{
+    /// Who was charged
+    BlockOwner owner;
+    /// Pads the header so the block after it keeps the alignment malloc guarantees
+    max_align_t alignment;
+};
+
+/**
+ * Gets the number of bytes the heap set aside for a block, less its header, which is what a later free gives back.
+ * @param header the start of a block returned by malloc
+ * @return the size
+ */
+static size_t heldSize(BlockHeader *header) {
+#ifdef _WIN32
+    return _msize(header) - sizeof(BlockHeader);
+#else
+    return malloc_usable_size(header) - sizeof(BlockHeader);
+#endif
+}
+
+/**
+ * Allocates memory for operator new, counting it when a ledger is installed.
+ * @param size the number of bytes requested
+ * @return the memory, or null if none could be found
+ */
+static void *allocate(size_t size) {
+    if (size > SIZE_MAX - sizeof(BlockHeader)) {
+        return nullptr;
+    }
+    BlockHeader *header = static_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + size));
+    while (header == nullptr) {
+        new_handler handler = get_new_handler();
+        if (handler == nullptr) {
+            return nullptr;
+        }
+        handler();
+        header = static_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + size));
+    }
+    header->owner.ledger = 0;
+    header->owner.phase = activePhase;
+    if (activeLedger != nullptr) {
+        header->owner.ledger = activeLedger->getSerial();
+        activeLedger->allocated(activePhase, size, heldSize(header));
+    }
+    return header + 1;
+}
+
+/**
+ * Frees memory for operator delete, crediting the ledger that allocated it when that ledger is installed. A ledger
+ * which is not installed may no longer exist, so it is never touched.
+ * @param block the memory, may be null
+ */
+static void release(void *block) {
+    if (block == nullptr) {
+        return;
+    }
+    BlockHeader *header = static_cast<BlockHeader *>(block) - 1;
+    if (activeLedger != nullptr && header->owner.ledger == activeLedger->getSerial()) {
+        activeLedger->freed(header->owner.phase, heldSize(header));
+    }
+    free(header);
+}
+
+void *operator new(size_t size) {
+    void *block = allocate(size);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void *block) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block) noexcept {
+    release(block);
+}
+
+void operator delete(void *block, size_t) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block, size_t) noexcept {
+    release(block);
+}
+
+void operator delete(void *block, const nothrow_t &) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block, const nothrow_t &) noexcept {
+    release(block);
+}
+
+#endif
+
+AllocationLedger::AllocationLedger()
+{
+    for (Counters &counters : phases) {
+        counters.allocations = 0;
+        counters.bytes = 0;
+        counters.live = 0;
+        counters.peak = 0;
+    }
+    total.allocations = 0;
+    total.bytes = 0;
+    total.live = 0;
+    total.peak = 0;
+    serial = lastSerial.fetch_add(1, memory_order_relaxed) + 1;
+}
+
+void AllocationLedger::adjust(Counters &counters, long long change) {
+    long long live = counters.live.fetch_add(change, memory_order_relaxed) + change;
+    long long peak = counters.peak.load(memory_order_relaxed);
+    while (live > peak && !counters.peak.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+    }
+}
+
+void AllocationLedger::allocated(AllocationPhase phase, size_t requested, size_t held) {
+    phases[phase].allocations.fetch_add(1, memory_order_relaxed);
+    phases[phase].bytes.fetch_add(requested, memory_order_relaxed);
+    adjust(phases[phase], static_cast<long long>(held));
+    total.allocations.fetch_add(1, memory_order_relaxed);
+    total.bytes.fetch_add(requested, memory_order_relaxed);
+    adjust(total, static_cast<long long>(held));
+}
+
+void AllocationLedger::freed(AllocationPhase phase, size_t held) {
+    adjust(phases[phase], -static_cast<long long>(held));
+    adjust(total, -static_cast<long long>(held));
+}
+
+unsigned long long AllocationLedger::getSerial() const {
+    return serial;
+}
+
+AllocationCounts AllocationLedger::getCounts(AllocationPhase phase) const {
+    AllocationCounts counts;
+    counts.allocations = phases[phase].allocations.load(memory_order_relaxed);
+    counts.bytes = phases[phase].bytes.load(memory_order_relaxed);
+    counts.peak = phases[phase].peak.load(memory_order_relaxed);
+    return counts;
+}
+
+AllocationCounts AllocationLedger::getTotal() const {
+    AllocationCounts counts;
+    counts.allocations = total.allocations.load(memory_order_relaxed);
+    counts.bytes = total.bytes.load(memory_order_relaxed);
+    counts.peak = total.peak.load(memory_order_relaxed);
+    return counts;
+}
+
+void AllocationLedger::merge(const AllocationLedger &other) {
+    for (int phase = 0; phase <= PHASE_COUNT; ++phase) {
+        Counters &counters = phase == PHASE_COUNT ? total : phases[phase];
+        const Counters &added = phase == PHASE_COUNT ? other.total : other.phases[phase];
+        counters.allocations.fetch_add(added.allocations.load(memory_order_relaxed), memory_order_relaxed);
+        counters.bytes.fetch_add(added.bytes.load(memory_order_relaxed), memory_order_relaxed);
+        long long addedPeak = added.peak.load(memory_order_relaxed);
+        long long peak = counters.peak.load(memory_order_relaxed);
+        while (addedPeak > peak && !counters.peak.compare_exchange_weak(peak, addedPeak, memory_order_relaxed)) {
+        }
+    }
+}
+
+void AllocationLedger::save(std::ostream &out) const {
+    for (int phase = 0; phase <= PHASE_COUNT; ++phase) {
+        const Counters &counters = phase == PHASE_COUNT ? total : phases[phase];
+        out << (phase == 0 ? "" : " ") << counters.allocations.load(memory_order_relaxed) << " "
+            << counters.bytes.load(memory_order_relaxed) << " " << counters.peak.load(memory_order_relaxed);
+    }
+    out << "\n";
+}
+
+bool AllocationLedger::load(std::istream &in) {
+    for (int phase = 0; phase <= PHASE_COUNT; ++phase) {
+        Counters &counters = phase == PHASE_COUNT ? total : phases[phase];
+        unsigned long long allocations = 0;
+        unsigned long long bytes = 0;
+        long long peak = 0;
+        if (!(in >> allocations >> bytes >> peak)) {
+            return false;
+        }
+        counters.allocations = allocations;
+        counters.bytes = bytes;
+        counters.live = 0;
+        counters.peak = peak;
+    }
+    return true;
+}
+
+AllocationScope::AllocationScope(AllocationLedger *ledger, AllocationPhase phase) :
+    previousLedger(activeLedger),
+    previousPhase(activePhase)
+{
+    activeLedger = ledger;
+    activePhase = phase;
+}
+
+AllocationScope::AllocationScope(AllocationPhase phase) :
+    previousLedger(activeLedger),
+    previousPhase(activePhase)
+{
+    activePhase = phase;
+}
+
+AllocationScope::~AllocationScope()
+{
+    activeLedger = previousLedger;
+    activePhase = previousPhase;
+}
+
+AllocationLedger *AllocationScope::currentLedger() {
+    return activeLedger;
+}
+
+bool AllocationScope::isTracking() {
+#ifdef PARSER_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
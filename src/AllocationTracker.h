@@ -0,0 +1,196 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Contains the classes which count heap allocations made while a file is lexed, parsed and written out.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_ALLOCATIONTRACKER_H_H
+#define PROJECT1_ALLOCATIONTRACKER_H_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+/**
+ * The parts of a parse that allocations are charged to.
+ */
+enum AllocationPhase
+{
+    LEX_PHASE, PARSE_PHASE, OUTPUT_PHASE, PHASE_COUNT
+};
+
+/**
+ * @brief Allocation counts for one phase, or for a whole file.
+ */
+struct AllocationCounts
+{
+    /// Number of allocations
+    unsigned long long allocations;
+    /// Total bytes requested
+    unsigned long long bytes;
+    /// The most bytes held at once, counted from when the ledger was installed
+    long long peak;
+};
+
+/**
+ * @brief Counts the allocations made on behalf of one file.
+ * @details The global operator new charges every allocation to the ledger installed on the calling thread by an
+ * AllocationScope, split by the phase of that scope, and notes the ledger and phase in a small header in front of the
+ * block. operator delete credits the free back to that same ledger and phase, but only while the ledger is installed
+ * on the freeing thread: memory allocated before a ledger was installed, or by another ledger, never lowers its
+ * counts, and memory a ledger still holds when its scope ends simply stays counted as live. Live bytes therefore
+ * never drop below zero and peaks are exact for each phase. The counters are atomic because lexing threads charge the
+ * same ledger as the parser. operator new and delete are only replaced in a build with PARSER_TRACK_ALLOCATIONS
+ * defined; any other build uses the standard ones, which put no header in front of a block and count nothing.
+ */
+class AllocationLedger
+{
+private:
+
+    /**
+     * @brief Running counters for one phase.
+     */
+    struct Counters
+    {
+        /// Number of allocations
+        std::atomic<unsigned long long> allocations;
+        /// Total bytes requested
+        std::atomic<unsigned long long> bytes;
+        /// Bytes currently held, as sized by the heap
+        std::atomic<long long> live;
+        /// The highest value live has reached
+        std::atomic<long long> peak;
+    };
+
+    /// The counters of each phase
+    Counters phases[PHASE_COUNT];
+    /// The counters of the file as a whole
+    Counters total;
+    /// Identifies the ledger in block headers; unlike its address it is never reused by a later ledger
+    unsigned long long serial;
+
+    /**
+     * Adds to the live bytes of a set of counters and raises its peak.
+     * @param counters the counters to change
+     * @param change the number of bytes allocated, negative when freed
+     */
+    static void adjust(Counters &counters, long long change);
+
+public:
+
+    /**
+     * AllocationLedger Constructor
+     * @return A ledger with every count at zero
+     */
+    AllocationLedger();
+
+    /**
+     * Records an allocation.
+     * @param phase the phase making the allocation
+     * @param requested the number of bytes asked for
+     * @param held the number of bytes the heap actually set aside
+     */
+    void allocated(AllocationPhase phase, size_t requested, size_t held);
+
+    /**
+     * Records a free.
+     * @param phase the phase which made the allocation
+     * @param held the number of bytes the heap had set aside
+     */
+    void freed(AllocationPhase phase, size_t held);
+
+    /**
+     * Gets the serial number which identifies this ledger for as long as the program runs.
+     * @return the serial number, never 0
+     */
+    unsigned long long getSerial() const;
+
+    /**
+     * Gets the counts of one phase.
+     * @param phase the phase
+     * @return the counts
+     */
+    AllocationCounts getCounts(AllocationPhase phase) const;
+
+    /**
+     * Gets the counts of every phase together.
+     * @return the counts
+     */
+    AllocationCounts getTotal() const;
+
+    /**
+     * Adds the counts of another ledger to this one, keeping the larger peaks. Used to total a run.
+     * @param other the ledger to add
+     */
+    void merge(const AllocationLedger &other);
+
+    /**
+     * Writes the counts of every phase on one line in a form load reads back, for passing them between processes.
+     * @param out the stream to write to
+     */
+    void save(std::ostream &out) const;
+
+    /**
+     * Replaces the counts with ones written by save. Bytes currently held are not saved and read back as zero.
+     * @param in the stream to read from
+     * @return true if they were read, false if the input is malformed
+     */
+    bool load(std::istream &in);
+};
+
+/**
+ * @brief Charges the allocations of the calling thread to a ledger and phase until the scope ends.
+ * @details Scopes nest; the previous ledger and phase are restored by the destructor. No allocations are counted on a
+ * thread which has no ledger installed, which is the default, so in a tracking build the only cost without --memory
+ * is reading a thread local pointer in operator new and operator delete.
+ */
+class AllocationScope
+{
+private:
+    /// The ledger that was installed before this scope
+    AllocationLedger *previousLedger;
+    /// The phase that was active before this scope
+    AllocationPhase previousPhase;
+
+public:
+
+    /**
+     * AllocationScope Constructor, installs a ledger and phase on the calling thread.
+     * @param ledger the ledger to charge, may be null to stop counting
+     * @param phase the phase to charge
+     * @return An AllocationScope object
+     */
+    AllocationScope(AllocationLedger *ledger, AllocationPhase phase);
+
+    /**
+     * AllocationScope Constructor, changes the phase while keeping the current ledger.
+     * @param phase the phase to charge
+     * @return An AllocationScope object
+     */
+    explicit AllocationScope(AllocationPhase phase);
+
+    /**
+     * AllocationScope Destructor, restores the previous ledger and phase.
+     */
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+    /**
+     * Gets the ledger installed on the calling thread, so that threads started on its behalf can charge it too.
+     * @return the ledger, or null when allocations are not being counted
+     */
+    static AllocationLedger *currentLedger();
+
+    /**
+     * Checks whether this build replaces operator new and delete, without which no allocation is ever counted.
+     * @return true if PARSER_TRACK_ALLOCATIONS was defined
+     */
+    static bool isTracking();
+};
+
+#endif
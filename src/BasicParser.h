@@ -0,0 +1,485 @@
+/**
+ * @file BasicParser.h
+ * @brief Contains the BasicParser class template, which parses the grammar and reports what it finds to a handler.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_BASICPARSER_H_H
+#define PROJECT1_BASICPARSER_H_H
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Lexer.h"
+#include "ParseHandler.h"
+
+/**
+ * @brief Asks a handler whether it holds the events of the Panel about to be parsed, for handlers with a
+ * bool replayPanel(Token &token) member that reports them and moves the lexer past the Panel, setting token to the
+ * one after it. Handlers without the member are never asked. The member is not part of ParseHandler; a handler that
+ * keeps it private makes this a friend.
+ * @tparam Handler the handler
+ */
+template<typename Handler, typename = void>
+struct PanelReplay
+{
+    /**
+     * Does nothing, the handler cannot replay Panels.
+     * @return false
+     */
+    static bool replay(Handler &, Token &)
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief PanelReplay for a handler which can replay Panels.
+ * @tparam Handler the handler
+ */
+template<typename Handler>
+struct PanelReplay<Handler, decltype(void(std::declval<Handler &>().replayPanel(std::declval<Token &>())))>
+{
+    /**
+     * Lets the handler replay the Panel.
+     * @param handler the handler
+     * @param token receives the token after the Panel when it is replayed
+     * @return true if the Panel was replayed
+     */
+    static bool replay(Handler &handler, Token &token)
+    {
+        return handler.replayPanel(token);
+    }
+};
+
+/**
+ * @brief Parses the grammar in a single pass, reporting each production, lexeme and widget to a handler.
+ * @details The handler is a template parameter rather than an interface, so every event is a direct call which
+ * inlines into the productions, and events a handler does not define cost nothing. Nothing is written or recorded
+ * except by the handler: a handler that only counts widgets pays for neither a trace nor a tree. See ParseHandler
+ * for the events and their order.
+ * @tparam Handler a ParseHandler or a class derived from it
+ */
+template<typename Handler>
+class BasicParser
+{
+private:
+    /// The lexer which will provide tokens and lexemes
+    Lexer &lexer;
+    /// Receives the events
+    Handler &handler;
+    /// A token whose value will be provided by the Lexer class
+    Token token;
+    /// The number of open Window, Panel and Group nodes
+    unsigned int depth;
+    /// The number of nodes open around the text being parsed, for a parser starting inside a file
+    unsigned int baseDepth;
+    /// The numbers of the layout being read, kept to reuse its storage
+    std::vector<int> layoutParams;
+
+    /**
+     * Validates the gui production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool gui_production();
+
+    /**
+     * Validates the layout production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool layout_production();
+
+    /**
+     * Validates the layout type production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool layout_type_production();
+
+    /**
+     * Validates the align production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool align_production();
+
+    /**
+     * Validates the widget production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool widget_production();
+
+    /**
+     * Validates the widgets production syntax.
+     * @return false, since the widget list only ends at a lexeme which is not a widget
+     */
+    bool widgets_production();
+
+    /**
+     * Validates the radio buttons production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool radio_buttons_production();
+
+    /**
+     * Validates the radio button production syntax.
+     * @return true if syntax is valid, false otherwise
+     */
+    bool radio_button_production();
+
+    /**
+     * Checks that a Panel or Group may open at the current depth, stopping the file if it would exceed the depth
+     * limit.
+     * @return true if it may open
+     */
+    bool checkDepth();
+
+public:
+
+    /**
+     * BasicParser Constructor
+     * @param source the lexer for the file, which must not have handed out any lexemes yet
+     * @param events the handler receiving the events
+     * @return A BasicParser object
+     */
+    BasicParser(Lexer &source, Handler &events);
+
+    /**
+     * Sets how many nodes are open around the text, when parsing a part of a file such as a single Panel.
+     * @param nodes the number of open nodes, counting the Window
+     */
+    void setBaseDepth(unsigned int nodes);
+
+    /**
+     * Parses a whole file.
+     * @return true if the whole file is syntactically valid, false otherwise
+     */
+    bool file();
+
+    /**
+     * Parses a single widget, such as a Panel lexed elsewhere.
+     * @return true if the widget is syntactically valid, false otherwise
+     */
+    bool widget();
+};
+
+/**
+ * @def PARSER_CHECK
+ * takes a conditional that compares the current token to the expected token value. If the token is valid syntactically
+ * then the process continues by reporting the lexeme and getting the next token. Otherwise the process fails.
+ */
+#define PARSER_CHECK(COND) \
+    if(COND){ \
+        handler.onToken(token, lexer.getCurrentLexeme());\
+        token = lexer.getNextToken(); \
+    } \
+    else{ \
+        ret = false;\
+        goto cleanup;\
+    }
+
+/**
+ * @def PRODUCTION_CHECK
+ * takes a conditional that compares whether a production function succeeded or not.
+ */
+#define PRODUCTION_CHECK(COND)\
+    if(!COND){\
+        ret = false;\
+        goto cleanup;\
+    }
+
+template<typename Handler>
+BasicParser<Handler>::BasicParser(Lexer &source, Handler &events) :
+    lexer(source),
+    handler(events),
+    token(NONE),
+    depth(0),
+    baseDepth(0)
+{
+}
+
+template<typename Handler>
+void BasicParser<Handler>::setBaseDepth(unsigned int nodes) {
+    baseDepth = nodes;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::file() {
+    token = lexer.getNextToken();
+    return gui_production();
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::widget() {
+    token = lexer.getNextToken();
+    return widget_production();
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::checkDepth() {
+    unsigned int maxDepth = lexer.getLimits().maxDepth;
+    if (maxDepth && baseDepth + depth >= maxDepth) {
+        token = lexer.reportLimit("Nesting is deeper than the limit of " + std::to_string(maxDepth));
+        return false;
+    }
+    return true;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::gui_production(){
+    bool ret = true;
+    // the title is only reported with the size, by which time the lexer has moved on
+    std::string title;
+    int width = 0;
+    int height = 0;
+    handler.onEnter("GUI");
+
+    PARSER_CHECK(token == WINDOW);
+
+    PARSER_CHECK(token == STRING);
+    title = lexer.getPreviousLexeme();
+
+    PARSER_CHECK(token == OPENPAREN);
+
+    PARSER_CHECK(token == NUMBER);
+    width = lexer.getPreviousNumber();
+
+    PARSER_CHECK(token == COMMA);
+
+    PARSER_CHECK(token == NUMBER);
+    height = lexer.getPreviousNumber();
+
+    PARSER_CHECK(token == CLOSEPAREN);
+    handler.onWindow(title, width, height);
+    ++depth;
+
+    PRODUCTION_CHECK(layout_production());
+
+    widgets_production();
+
+    PARSER_CHECK(token == END);
+
+    // At end of file so we can't use PARSER_CHECK which tries to get another token
+    // should fix this in case a file has more after the end of the production
+    if (token == PERIOD) {
+        handler.onToken(token, lexer.getCurrentLexeme());
+        handler.onWindowEnd();
+        --depth;
+    }
+    else {
+        ret = false;
+        goto cleanup;
+    }
+cleanup:
+    if (ret == false){
+        handler.onError(token != NONE ? SYNTAX_ERROR : lexer.isLimitReached() ? LIMIT_ERROR : LEXICAL_ERROR,
+                        lexer.getCurrentLocation(), lexer.getDiagnostic(), token, lexer.getCurrentLexeme());
+    }
+    handler.onExit("GUI");
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::layout_production(){
+    bool ret = true;
+    handler.onEnter("Layout");
+    PARSER_CHECK(token == LAYOUT);
+
+    PRODUCTION_CHECK(layout_type_production());
+
+    PARSER_CHECK(token == COLON);
+
+cleanup:
+    handler.onExit("Layout");
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::layout_type_production(){
+    bool ret = true;
+    Token type = token;
+    Token align = NONE;
+    handler.onEnter("Layout Type");
+    layoutParams.clear();
+
+    PARSER_CHECK(token == FLOW || token == BORDER || token == GRID);
+
+    PARSER_CHECK(token == OPENPAREN);
+
+    switch(type){
+        case FLOW: {
+            if (token != CLOSEPAREN) {
+                align = token;
+                PRODUCTION_CHECK(align_production());
+            }
+            break;
+        }
+        case BORDER:{
+            if(token != CLOSEPAREN) {
+                PARSER_CHECK(token == NUMBER);
+                layoutParams.push_back(lexer.getPreviousNumber());
+
+                PARSER_CHECK(token == COMMA);
+
+                PARSER_CHECK(token == NUMBER);
+                layoutParams.push_back(lexer.getPreviousNumber());
+            }
+            break;
+        }
+        case GRID:{
+            PARSER_CHECK(token == NUMBER);
+            layoutParams.push_back(lexer.getPreviousNumber());
+
+            PARSER_CHECK(token == COMMA);
+
+            PARSER_CHECK(token == NUMBER);
+            layoutParams.push_back(lexer.getPreviousNumber());
+            if(token != CLOSEPAREN) {
+                PARSER_CHECK(token == COMMA);
+
+                PARSER_CHECK(token == NUMBER);
+                layoutParams.push_back(lexer.getPreviousNumber());
+
+                PARSER_CHECK(token == COMMA);
+
+                PARSER_CHECK(token == NUMBER);
+                layoutParams.push_back(lexer.getPreviousNumber());
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    PARSER_CHECK(token == CLOSEPAREN);
+    handler.onLayout(type, align, layoutParams);
+
+cleanup:
+    handler.onExit("Layout Type");
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::align_production(){
+    bool ret = true;
+    handler.onEnter("Align");
+
+    PARSER_CHECK(token == LEFT || token == RIGHT || token == CENTER);
+
+cleanup:
+    handler.onExit("Align");
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::widget_production(){
+    if (token == PANEL && PanelReplay<Handler>::replay(handler, token)) {
+        return true;
+    }
+    bool ret = true;
+    Token kind = token;
+    handler.onEnter("Widget");
+
+    switch(token){
+        case BUTTON:
+        case LABEL:{
+            PARSER_CHECK(token == kind);
+            PARSER_CHECK(token == STRING);
+            handler.onWidget(kind, lexer.getPreviousLexeme(), 0);
+            break;
+        }
+        case GROUP:{
+            PRODUCTION_CHECK(checkDepth());
+            PARSER_CHECK(token == GROUP);
+            handler.onGroupBegin();
+            ++depth;
+            radio_buttons_production();
+            PARSER_CHECK(token == END);
+            handler.onGroupEnd();
+            --depth;
+            break;
+        }
+        case PANEL:{
+            PRODUCTION_CHECK(checkDepth());
+            PARSER_CHECK(token == PANEL);
+            handler.onPanelBegin();
+            ++depth;
+            PRODUCTION_CHECK(layout_production());
+            widgets_production();
+            PARSER_CHECK(token == END);
+            handler.onPanelEnd();
+            --depth;
+            break;
+        }
+        case TEXTFIELD:{
+            PARSER_CHECK(token == TEXTFIELD);
+            PARSER_CHECK(token == NUMBER);
+            handler.onWidget(TEXTFIELD, std::string(), lexer.getPreviousNumber());
+            break;
+        }
+        default:{
+            ret = false;
+            goto cleanup;
+        }
+    }
+
+    PARSER_CHECK(token == SEMICOLON);
+
+cleanup:
+    handler.onExit("Widget");
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::widgets_production(){
+    // widgets ::= widget widgets is right recursive, so recursing would use stack for every widget. Loop instead,
+    // reporting the same productions: one Entering per widget tried and the matching Exitings once a widget fails.
+    size_t entered = 0;
+    do {
+        handler.onEnter("Widgets");
+        ++entered;
+    } while (widget_production());
+
+    for (; entered > 0; --entered) {
+        handler.onExit("Widgets");
+    }
+    // the innermost widgets production always fails, and so every one above it does too
+    return false;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::radio_buttons_production(){
+    // looped for the same reason as widgets_production; only the outermost result matters, which is whether the
+    // first radio button parsed
+    size_t entered = 0;
+    do {
+        handler.onEnter("Radio Buttons");
+        ++entered;
+    } while (radio_button_production());
+
+    bool ret = entered > 1;
+    for (; entered > 0; --entered) {
+        handler.onExit("Radio Buttons");
+    }
+    return ret;
+}
+
+template<typename Handler>
+bool BasicParser<Handler>::radio_button_production(){
+    bool ret = true;
+    handler.onEnter("Radio Button");
+    PARSER_CHECK(token == RADIO);
+    PARSER_CHECK(token == STRING);
+    handler.onWidget(RADIO, lexer.getPreviousLexeme(), 0);
+    PARSER_CHECK(token == SEMICOLON);
+
+cleanup:
+    handler.onExit("Radio Button");
+    return ret;
+}
+
+#undef PARSER_CHECK
+#undef PRODUCTION_CHECK
+
+#endif
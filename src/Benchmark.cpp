@@ -0,0 +1,93 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Contains the source code for the --benchmark mode of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Parser.h"
+
+using namespace std;
+
+void run_lexer_benchmark(const string &fileName, unsigned int maxThreads, unsigned int minimumChunk) {
+    const int repetitions = 5;
+    Lexer serial((std::experimental::filesystem::path(fileName)));
+    serial.lexAhead(1);
+    const vector<LexedToken> &expected = serial.getLexedTokens();
+    unsigned long long bytes = serial.getSource().length();
+    cout << "Lexer benchmark: " << fileName << " (" << bytes << " bytes, " << expected.size()
+        << " tokens, chunks of at least " << minimumChunk << " bytes)\n"
+        << "threads\tchunks\tbest ms\tspeedup" << endl;
+
+    double serialMs = 0;
+    for (unsigned int threads = 1; ; threads *= 2) {
+        threads = std::min(threads, maxThreads);
+        double best = 0;
+        for (int run = 0; run < repetitions; ++run) {
+            Lexer lexer((std::experimental::filesystem::path(fileName)));
+            auto start = chrono::steady_clock::now();
+            lexer.lexAhead(threads, minimumChunk);
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+            const vector<LexedToken> &tokens = lexer.getLexedTokens();
+            bool same = tokens.size() == expected.size();
+            for (size_t i = 0; same && i < tokens.size(); ++i) {
+                same = tokens[i].token == expected[i].token && tokens[i].lexeme == expected[i].lexeme &&
+                    tokens[i].offset == expected[i].offset;
+            }
+            if (!same) {
+                cout << "Token stream with " << threads << " threads differs from the serial lexer" << endl;
+                exit(1);
+            }
+        }
+        if (threads == 1) {
+            serialMs = best;
+        }
+        // the same split lexAhead makes: a chunk per thread, but none shorter than minimumChunk
+        unsigned long long chunks = std::max(1ull, std::min<unsigned long long>(threads, bytes / minimumChunk));
+        cout << threads << "\t" << chunks << "\t" << fixed << setprecision(3) << best << "\t" << setprecision(2)
+            << (best > 0 ? serialMs / best : 1.0) << endl;
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+}
+
+void run_parser_benchmark(const string &fileName, const string &outfile) {
+    const int repetitions = 5;
+    cout << "Parser benchmark: " << fileName << "\n" << "mode\t\tbest ms" << endl;
+    double synchronousMs = 0;
+    for (int pipelined = 0; pipelined < 2; ++pipelined) {
+        double best = 0;
+        for (int run = 0; run < repetitions; ++run) {
+            Parser parser(std::experimental::filesystem::path(fileName), outfile, false);
+            auto start = chrono::steady_clock::now();
+            if (pipelined) {
+                parser.pipeline();
+            }
+            parser.file();
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        if (!pipelined) {
+            synchronousMs = best;
+        }
+        cout << (pipelined ? "pipelined" : "synchronous") << "\t" << fixed << setprecision(3) << best;
+        if (pipelined) {
+            cout << "\t(" << setprecision(2) << (best > 0 ? synchronousMs / best : 1.0) << "x)";
+        }
+        cout << endl;
+    }
+}
@@ -0,0 +1,30 @@
+/**
+ * @file Benchmark.h
+ * @brief Contains the --benchmark mode of the driver, which times the ways of lexing and parsing a single file.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_BENCHMARK_H_H
+#define PROJECT1_BENCHMARK_H_H
+
+#pragma once
+
+#include <string>
+
+/**
+ * Times lexing a file up front with an increasing number of threads and checks every run against the serial tokens.
+ * Exits with 1 if any run produces different tokens.
+ * @param fileName the file to lex
+ * @param maxThreads the largest number of threads to try
+ * @param minimumChunk the fewest bytes given to a thread, which limits how many chunks a small file is split into
+ */
+void run_lexer_benchmark(const std::string &fileName, unsigned int maxThreads, unsigned int minimumChunk);
+
+/**
+ * Times parsing a file with lexing done in lockstep on the parser thread and with lexing pipelined on its own thread.
+ * @param fileName the file to parse
+ * @param outfile the file receiving the parser output
+ */
+void run_parser_benchmark(const std::string &fileName, const std::string &outfile);
+
+#endif //PROJECT1_BENCHMARK_H_H
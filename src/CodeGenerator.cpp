@@ -0,0 +1,178 @@
+/**
+ * @file CodeGenerator.cpp
+ * @brief Contains the source code for the CodeGenerator class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "CodeGenerator.h"
+
+using namespace std;
+
+/**
+ * Maps a token to the name of the matching generated Kind enumerator.
+ * @param token the token
+ * @return the enumerator name
+ */
+static const char *kindName(Token token) {
+    switch (token) {
+        case WINDOW: return "Kind::Window";
+        case PANEL: return "Kind::Panel";
+        case GROUP: return "Kind::Group";
+        case BUTTON: return "Kind::Button";
+        case LABEL: return "Kind::Label";
+        case TEXTFIELD: return "Kind::Textfield";
+        case RADIO: return "Kind::Radio";
+        case FLOW: return "Kind::Flow";
+        case BORDER: return "Kind::Border";
+        case GRID: return "Kind::Grid";
+        case LEFT: return "Kind::Left";
+        case RIGHT: return "Kind::Right";
+        case CENTER: return "Kind::Center";
+        default: return "Kind::None";
+    }
+}
+
+/**
+ * Writes a list of ints as the body of a fixed size array initializer, padding with zeros.
+ * @param out the stream to write to
+ * @param values the values
+ * @param size the size of the array
+ */
+static void writeArray(ostream &out, const vector<int> &values, size_t size) {
+    out << "{";
+    for (size_t i = 0; i < size; ++i) {
+        out << (i ? ", " : "") << (i < values.size() ? values[i] : 0);
+    }
+    out << "}";
+}
+
+CodeGenerator::CodeGenerator(const Descriptor &descriptorval, std::string nameval, std::string sourceval)
+    throw(runtime_error) :
+    descriptor(descriptorval),
+    name(nameval),
+    source(sourceval)
+{
+    if (!descriptor.isComplete()) {
+        throw runtime_error("Cannot generate code for an incomplete descriptor");
+    }
+}
+
+unsigned int CodeGenerator::stringIndex(const std::string *text) {
+    for (unsigned int i = 0; i < strings.size(); ++i) {
+        if (strings[i] == text) {
+            return i;
+        }
+    }
+    strings.push_back(text);
+    return static_cast<unsigned int>(strings.size()) - 1;
+}
+
+void CodeGenerator::write(std::ostream &out) {
+    const vector<DescriptorNode> &nodes = descriptor.getNodes();
+    vector<int> textIndexes;
+    for (const DescriptorNode &node : nodes) {
+        bool hasText = node.kind == WINDOW || node.kind == BUTTON || node.kind == LABEL || node.kind == RADIO;
+        textIndexes.push_back(hasText ? static_cast<int>(stringIndex(node.text)) : -1);
+    }
+
+    string guard("PROJECT1_GENERATED_" + name + "_H");
+    for (char &c : guard) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+
+    out << "// Generated from " << source << " by the CMSC 330 Project 1 parser. Do not edit.\n"
+        << "#ifndef " << guard << "\n"
+        << "#define " << guard << "\n\n"
+        << "namespace " << name << " {\n\n"
+        << "enum class Kind : unsigned char\n{\n"
+        << "    None, Window, Panel, Group, Button, Label, Textfield, Radio, Flow, Border, Grid, Left, Right, Center\n"
+        << "};\n\n"
+        << "struct Node\n{\n"
+        << "    Kind kind;\n"
+        << "    Kind layout;\n"
+        << "    Kind align;\n"
+        << "    int text;\n"
+        << "    unsigned char numberCount;\n"
+        << "    int numbers[2];\n"
+        << "    unsigned char layoutParamCount;\n"
+        << "    int layoutParams[4];\n"
+        << "    unsigned int parent;\n"
+        << "    unsigned int end;\n"
+        << "};\n\n";
+
+    out << "constexpr const char *strings[] = {\n";
+    for (const string *text : strings) {
+        out << "    \"";
+        for (char c : *text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                // always three digits, so a digit after it cannot be read as part of the escape
+                out << "\\" << oct << setw(3) << setfill('0') << static_cast<int>(c) << dec << setfill(' ');
+            }
+            else {
+                out << c;
+            }
+        }
+        out << "\",\n";
+    }
+    out << "};\n"
+        << "constexpr unsigned int stringCount = " << strings.size() << ";\n\n";
+
+    out << "constexpr Node nodes[] = {\n";
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const DescriptorNode &node = nodes[i];
+        out << "    {" << kindName(node.kind) << ", " << kindName(node.layout) << ", " << kindName(node.align) << ", "
+            << textIndexes[i] << ", " << node.numbers.size() << ", ";
+        writeArray(out, node.numbers, 2);
+        out << ", " << node.layoutParams.size() << ", ";
+        writeArray(out, node.layoutParams, 4);
+        out << ", " << node.parent << ", " << node.end << "},\n";
+    }
+    out << "};\n"
+        << "constexpr unsigned int nodeCount = " << nodes.size() << ";\n\n"
+        << "}\n\n"
+        << "#endif\n";
+}
+
+bool CodeGenerator::writeFile(std::experimental::filesystem::path filename) throw(runtime_error) {
+    ostringstream generated;
+    write(generated);
+
+    ifstream existing(filename, ios::binary);
+    if (existing.is_open()) {
+        ostringstream current;
+        current << existing.rdbuf();
+        if (current.str() == generated.str()) {
+            return false;
+        }
+    }
+    existing.close();
+
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) {
+        throw runtime_error("Invalid path to generated header");
+    }
+    out << generated.str();
+    return true;
+}
+
+std::string CodeGenerator::identifierFor(std::experimental::filesystem::path filename) {
+    string identifier(filename.stem().string());
+    for (char &c : identifier) {
+        if (!isalnum(static_cast<unsigned char>(c))) {
+            c = '_';
+        }
+    }
+    if (identifier.empty() || isdigit(static_cast<unsigned char>(identifier[0]))) {
+        identifier.insert(0, "gui_");
+    }
+    return identifier;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file CodeGenerator.h
+ * @brief Contains the CodeGenerator class definition, which emits a parsed descriptor as a constexpr C++ header.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_CODEGENERATOR_H_H
+#define PROJECT1_CODEGENERATOR_H_H
+
+#pragma once
+
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Descriptor.h"
+
+/**
+ * @brief Writes the widget tree of a successful parse as constexpr arrays so it can be compiled into a binary.
+ * @details The generated header lives in its own namespace and contains:\n
+ *  strings - every distinct Window, Button, Label and Radio text\n
+ *  nodes - the widget tree in pre-order, where node i owns the nodes in [i, nodes[i].end)\n
+ */
+class CodeGenerator
+{
+private:
+    /// The tree to be emitted
+    const Descriptor &descriptor;
+    /// The namespace holding the generated data
+    std::string name;
+    /// The input file name, recorded in the header comment
+    std::string source;
+    /// Distinct strings in order of first appearance, as stored in the StringTable of the descriptor
+    std::vector<const std::string *> strings;
+
+    /**
+     * Finds the index of a string in the string table, adding it if needed.
+     * @param text the string to be looked up, as stored in the StringTable of the descriptor
+     * @return the index
+     */
+    unsigned int stringIndex(const std::string *text);
+
+public:
+
+    /**
+     * CodeGenerator Constructor
+     * @param descriptor a complete descriptor
+     * @param name the namespace for the generated data, must be a valid identifier
+     * @param source the name of the input file
+     * @return A CodeGenerator object
+     * @throw runtime_error if the descriptor is incomplete
+     */
+    CodeGenerator(const Descriptor &descriptor, std::string name, std::string source) throw(std::runtime_error);
+
+    /**
+     * Writes the header to a stream.
+     * @param out the stream to write to
+     */
+    void write(std::ostream &out);
+
+    /**
+     * Writes the header to a file, leaving the file untouched when its contents would not change so that
+     * dependent objects are only rebuilt when the input changes.
+     * @param filename the header to be written
+     * @return true if the file was written, false if it was already up to date
+     * @throw runtime_error if the file cannot be written
+     */
+    bool writeFile(std::experimental::filesystem::path filename) throw(std::runtime_error);
+
+    /**
+     * Builds a valid C++ identifier from a file name, e.g. input1.txt becomes input1.
+     * @param filename the input file
+     * @return the identifier
+     */
+    static std::string identifierFor(std::experimental::filesystem::path filename);
+};
+
+#endif
@@ -0,0 +1,374 @@
+/**
+ * @file CorpusIndex.cpp
+ * @brief Contains the source code for the CorpusIndexBuilder and CorpusIndex classes
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "CorpusIndex.h"
+
+using namespace std;
+
+/// Identifies an index file and its format version
+static const char indexMagic[8] = { 'G', 'U', 'I', 'I', 'D', 'X', '1', '\0' };
+
+const std::vector<std::string> CorpusIndex::fieldNames = {
+    "window.width", "window.height", "textfield.width",
+    "grid.rows", "grid.columns", "grid.hgap", "grid.vgap",
+    "border.hgap", "border.vgap"
+};
+
+/**
+ * Maps a token to the name used for it in index terms.
+ * @param token the token
+ * @return the name
+ */
+static const char *termName(Token token) {
+    switch (token) {
+        case WINDOW: return "Window";
+        case PANEL: return "Panel";
+        case GROUP: return "Group";
+        case BUTTON: return "Button";
+        case LABEL: return "Label";
+        case TEXTFIELD: return "Textfield";
+        case RADIO: return "Radio";
+        case FLOW: return "Flow";
+        case BORDER: return "Border";
+        case GRID: return "Grid";
+        case LEFT: return "Left";
+        case RIGHT: return "Right";
+        case CENTER: return "Center";
+        default: return "None";
+    }
+}
+
+void CorpusIndexBuilder::add(const std::string &path, const Descriptor &descriptor) {
+    Entry entry;
+    entry.path = path;
+    for (const DescriptorNode &node : descriptor.getNodes()) {
+        string kind(termName(node.kind));
+        entry.terms.push_back(kind);
+        if (node.kind == WINDOW || node.kind == BUTTON || node.kind == LABEL || node.kind == RADIO) {
+            entry.texts.push_back(make_pair(node.kind, node.text));
+        }
+        if (node.kind == WINDOW && node.numbers.size() == 2) {
+            entry.values.push_back(make_pair(0u, node.numbers[0]));
+            entry.values.push_back(make_pair(1u, node.numbers[1]));
+        }
+        if (node.kind == TEXTFIELD && !node.numbers.empty()) {
+            entry.values.push_back(make_pair(2u, node.numbers[0]));
+        }
+        if (node.layout != NONE) {
+            entry.terms.push_back(termName(node.layout));
+        }
+        if (node.align != NONE) {
+            entry.terms.push_back(string(termName(node.layout)) + "=" + termName(node.align));
+        }
+        // Grid fields start at 3 and Border fields at 7, in the order the numbers are written
+        uint32_t firstField = node.layout == GRID ? 3 : node.layout == BORDER ? 7 : 0;
+        if (firstField != 0) {
+            for (size_t i = 0; i < node.layoutParams.size(); ++i) {
+                entry.values.push_back(make_pair(firstField + static_cast<uint32_t>(i), node.layoutParams[i]));
+            }
+        }
+    }
+    std::sort(entry.terms.begin(), entry.terms.end());
+    entry.terms.erase(std::unique(entry.terms.begin(), entry.terms.end()), entry.terms.end());
+    std::sort(entry.texts.begin(), entry.texts.end());
+    entry.texts.erase(std::unique(entry.texts.begin(), entry.texts.end()), entry.texts.end());
+    std::sort(entry.values.begin(), entry.values.end());
+    entry.values.erase(std::unique(entry.values.begin(), entry.values.end()), entry.values.end());
+
+    lock_guard<mutex> guard(lock);
+    entries.push_back(std::move(entry));
+}
+
+size_t CorpusIndexBuilder::size() {
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+/**
+ * Appends the bytes of a section to the file image.
+ * @param image the file image
+ * @param values the entries of the section
+ * @return the offset of the section
+ */
+template<typename T>
+static uint64_t appendSection(string &image, const vector<T> &values) {
+    uint64_t offset = image.size();
+    if (!values.empty()) {
+        image.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+    return offset;
+}
+
+size_t CorpusIndexBuilder::write(std::experimental::filesystem::path filename) throw(runtime_error) {
+    lock_guard<mutex> guard(lock);
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.path < b.path; });
+
+    string characters;
+    vector<IndexFile> files;
+    map<string, vector<uint32_t>> postingLists;
+    // the terms naming a text are only spelled out once every file is in, once per distinct text
+    map<pair<Token, const string *>, vector<uint32_t>> kindTextLists;
+    map<const string *, vector<uint32_t>> textLists;
+    vector<IndexRange> ranges;
+    for (uint32_t id = 0; id < entries.size(); ++id) {
+        IndexFile file;
+        file.pathOffset = static_cast<uint32_t>(characters.size());
+        file.pathLength = static_cast<uint32_t>(entries[id].path.size());
+        characters += entries[id].path;
+        files.push_back(file);
+        // ids are visited in order, so every posting list comes out sorted
+        for (const string &term : entries[id].terms) {
+            postingLists[term].push_back(id);
+        }
+        for (const pair<Token, const string *> &text : entries[id].texts) {
+            kindTextLists[text].push_back(id);
+            // a file holding the same text in nodes of different kinds is listed once
+            vector<uint32_t> &textList = textLists[text.second];
+            if (textList.empty() || textList.back() != id) {
+                textList.push_back(id);
+            }
+        }
+        for (const pair<uint32_t, int32_t> &value : entries[id].values) {
+            IndexRange range;
+            range.field = value.first;
+            range.value = value.second;
+            range.file = id;
+            ranges.push_back(range);
+        }
+    }
+    for (auto &kindText : kindTextLists) {
+        string term(string(termName(kindText.first.first)) + "=" + *kindText.first.second);
+        postingLists[term] = std::move(kindText.second);
+    }
+    for (auto &text : textLists) {
+        postingLists["text=" + *text.first] = std::move(text.second);
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const IndexRange &a, const IndexRange &b) {
+        return a.field != b.field ? a.field < b.field : a.value != b.value ? a.value < b.value : a.file < b.file;
+    });
+
+    vector<IndexTerm> terms;
+    vector<uint32_t> postings;
+    for (const auto &postingList : postingLists) {
+        IndexTerm term;
+        term.keyOffset = static_cast<uint32_t>(characters.size());
+        term.keyLength = static_cast<uint32_t>(postingList.first.size());
+        term.first = static_cast<uint32_t>(postings.size());
+        term.count = static_cast<uint32_t>(postingList.second.size());
+        characters += postingList.first;
+        postings.insert(postings.end(), postingList.second.begin(), postingList.second.end());
+        terms.push_back(term);
+    }
+    if (characters.size() > UINT32_MAX) {
+        throw runtime_error("Index is too large");
+    }
+
+    IndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    header.fileCount = static_cast<uint32_t>(files.size());
+    header.termCount = static_cast<uint32_t>(terms.size());
+    header.postingCount = static_cast<uint32_t>(postings.size());
+    header.rangeCount = static_cast<uint32_t>(ranges.size());
+
+    string image(sizeof(header), '\0');
+    header.filesOffset = appendSection(image, files);
+    header.termsOffset = appendSection(image, terms);
+    header.postingsOffset = appendSection(image, postings);
+    header.rangesOffset = appendSection(image, ranges);
+    header.stringsOffset = image.size();
+    header.stringsSize = characters.size();
+    image += characters;
+    memcpy(&image[0], &header, sizeof(header));
+
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) {
+        throw runtime_error("Invalid path to index file");
+    }
+    out.write(image.data(), static_cast<streamsize>(image.size()));
+    if (!out) {
+        throw runtime_error("Cannot write index file");
+    }
+    return terms.size();
+}
+
+CorpusIndex::CorpusIndex(std::experimental::filesystem::path filename) throw(runtime_error) :
+    data(nullptr),
+    size(0)
+{
+#ifdef __linux__
+    int descriptor = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        throw runtime_error("Invalid path to index file");
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        size = static_cast<size_t>(status.st_size);
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        data = mapped == MAP_FAILED ? nullptr : static_cast<const char *>(mapped);
+    }
+    close(descriptor);
+#else
+    ifstream in(filename, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Invalid path to index file");
+    }
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+#endif
+    header = reinterpret_cast<const IndexHeader *>(data);
+    bool valid = data != nullptr && size >= sizeof(IndexHeader) && memcmp(header->magic, indexMagic, 8) == 0;
+    if (valid) {
+        valid = header->filesOffset + uint64_t(header->fileCount) * sizeof(IndexFile) <= size
+            && header->termsOffset + uint64_t(header->termCount) * sizeof(IndexTerm) <= size
+            && header->postingsOffset + uint64_t(header->postingCount) * sizeof(uint32_t) <= size
+            && header->rangesOffset + uint64_t(header->rangeCount) * sizeof(IndexRange) <= size
+            && header->stringsOffset + header->stringsSize <= size;
+    }
+    if (valid) {
+        files = reinterpret_cast<const IndexFile *>(data + header->filesOffset);
+        terms = reinterpret_cast<const IndexTerm *>(data + header->termsOffset);
+        postings = reinterpret_cast<const uint32_t *>(data + header->postingsOffset);
+        ranges = reinterpret_cast<const IndexRange *>(data + header->rangesOffset);
+        strings = data + header->stringsOffset;
+        // check every reference once here so queries never need to
+        for (uint32_t i = 0; valid && i < header->fileCount; ++i) {
+            valid = uint64_t(files[i].pathOffset) + files[i].pathLength <= header->stringsSize;
+        }
+        for (uint32_t i = 0; valid && i < header->termCount; ++i) {
+            valid = uint64_t(terms[i].keyOffset) + terms[i].keyLength <= header->stringsSize
+                && uint64_t(terms[i].first) + terms[i].count <= header->postingCount;
+        }
+    }
+    if (!valid) {
+#ifdef __linux__
+        if (data != nullptr) {
+            munmap(const_cast<char *>(data), size);
+        }
+#endif
+        throw runtime_error("Not an index file: " + filename.string());
+    }
+}
+
+CorpusIndex::~CorpusIndex()
+{
+#ifdef __linux__
+    if (data != nullptr) {
+        munmap(const_cast<char *>(data), size);
+        data = nullptr;
+    }
+#endif
+}
+
+std::vector<uint32_t> CorpusIndex::match(const std::string &clause) const throw(runtime_error) {
+    vector<uint32_t> matched;
+    size_t operatorStart = clause.find_first_of("<>=");
+    string name(clause.substr(0, operatorStart));
+    auto field = std::find(fieldNames.begin(), fieldNames.end(), name);
+
+    if (field == fieldNames.end()) {
+        // a term, found by binary search over the sorted keys
+        const IndexTerm *term = std::lower_bound(terms, terms + header->termCount, clause,
+            [this](const IndexTerm &entry, const string &key) {
+                return key.compare(0, string::npos, strings + entry.keyOffset, entry.keyLength) > 0;
+            });
+        if (term != terms + header->termCount
+            && clause.compare(0, string::npos, strings + term->keyOffset, term->keyLength) == 0) {
+            matched.assign(postings + term->first, postings + term->first + term->count);
+        }
+        return matched;
+    }
+
+    if (operatorStart == string::npos) {
+        throw runtime_error("Invalid query clause, expected a comparison: " + clause);
+    }
+    size_t operatorEnd = clause.find_first_not_of("<>=", operatorStart);
+    string comparison(clause.substr(operatorStart, operatorEnd - operatorStart));
+    string number(operatorEnd == string::npos ? string() : clause.substr(operatorEnd));
+    char *numberEnd = nullptr;
+    long value = strtol(number.c_str(), &numberEnd, 10);
+    if (number.empty() || *numberEnd != '\0' || value < INT_MIN || value > INT_MAX) {
+        throw runtime_error("Invalid query clause, expected a number: " + clause);
+    }
+
+    // the inclusive range of values that satisfy the comparison
+    long long low = INT_MIN;
+    long long high = INT_MAX;
+    if (comparison == "=") {
+        low = high = value;
+    }
+    else if (comparison == "<") {
+        high = value - 1LL;
+    }
+    else if (comparison == "<=") {
+        high = value;
+    }
+    else if (comparison == ">") {
+        low = value + 1LL;
+    }
+    else if (comparison == ">=") {
+        low = value;
+    }
+    else {
+        throw runtime_error("Invalid query clause, unknown comparison: " + clause);
+    }
+
+    uint32_t fieldId = static_cast<uint32_t>(field - fieldNames.begin());
+    const IndexRange *end = ranges + header->rangeCount;
+    const IndexRange *range = std::lower_bound(ranges, end, make_pair(fieldId, low),
+        [](const IndexRange &entry, const pair<uint32_t, long long> &key) {
+            return entry.field != key.first ? entry.field < key.first : entry.value < key.second;
+        });
+    for (; range != end && range->field == fieldId && range->value <= high; ++range) {
+        matched.push_back(range->file);
+    }
+    std::sort(matched.begin(), matched.end());
+    matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+    return matched;
+}
+
+std::vector<std::string> CorpusIndex::query(const std::vector<std::string> &clauses) const throw(runtime_error) {
+    vector<uint32_t> matched;
+    for (size_t i = 0; i < clauses.size(); ++i) {
+        vector<uint32_t> next(match(clauses[i]));
+        if (i == 0) {
+            matched.swap(next);
+        }
+        else {
+            vector<uint32_t> both;
+            std::set_intersection(matched.begin(), matched.end(), next.begin(), next.end(), back_inserter(both));
+            matched.swap(both);
+        }
+    }
+    vector<string> paths;
+    for (uint32_t id : matched) {
+        if (id < header->fileCount) {
+            paths.push_back(string(strings + files[id].pathOffset, files[id].pathLength));
+        }
+    }
+    return paths;
+}
+
+size_t CorpusIndex::fileCount() const {
+    return header->fileCount;
+}
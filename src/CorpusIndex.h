@@ -0,0 +1,226 @@
+/**
+ * @file CorpusIndex.h
+ * @brief Contains the CorpusIndexBuilder and CorpusIndex class definitions, an on-disk inverted index of the widgets,
+ * texts and layout numbers of many parsed files.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_CORPUSINDEX_H_H
+#define PROJECT1_CORPUSINDEX_H_H
+
+#pragma once
+
+#include <cstdint>
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Descriptor.h"
+
+/**
+ * @brief The start of an index file. Every section is an array of the structs below, at the given byte offset.
+ * @details Values are stored in the byte order of the machine that built the index, and every section starts on a
+ * four byte boundary so the file can be used in place once it is memory-mapped.
+ */
+struct IndexHeader
+{
+    /// "GUIIDX1" followed by a zero byte
+    char magic[8];
+    /// Number of IndexFile entries
+    uint32_t fileCount;
+    /// Number of IndexTerm entries
+    uint32_t termCount;
+    /// Number of file ids in the postings section
+    uint32_t postingCount;
+    /// Number of IndexRange entries
+    uint32_t rangeCount;
+    /// Offset of the IndexFile entries
+    uint64_t filesOffset;
+    /// Offset of the IndexTerm entries
+    uint64_t termsOffset;
+    /// Offset of the postings, each a uint32_t file id
+    uint64_t postingsOffset;
+    /// Offset of the IndexRange entries
+    uint64_t rangesOffset;
+    /// Offset of the characters of every path and term
+    uint64_t stringsOffset;
+    /// Number of characters in the strings section
+    uint64_t stringsSize;
+};
+
+/**
+ * @brief An indexed file, file ids are positions in the files section.
+ */
+struct IndexFile
+{
+    /// Offset of the path in the strings section
+    uint32_t pathOffset;
+    /// Length of the path
+    uint32_t pathLength;
+};
+
+/**
+ * @brief A term and the files containing it. Terms are sorted by key.
+ */
+struct IndexTerm
+{
+    /// Offset of the key in the strings section
+    uint32_t keyOffset;
+    /// Length of the key
+    uint32_t keyLength;
+    /// Index of the first file id in the postings section, the ids are sorted
+    uint32_t first;
+    /// Number of file ids
+    uint32_t count;
+};
+
+/**
+ * @brief One number of one file, such as the columns of a Grid. Sorted by field, then value, then file.
+ */
+struct IndexRange
+{
+    /// Index into CorpusIndex::fieldNames
+    uint32_t field;
+    /// The number
+    int32_t value;
+    /// The file id
+    uint32_t file;
+};
+
+/**
+ * @brief Collects the terms and numbers of parsed files and writes them out as an index.
+ * @details The terms of a file are the kinds of its nodes (Window, Panel, Button, ...), its layouts (Flow, Border,
+ * Grid), aligned flows (Flow=Center), each text together with the kind holding it (Button=Delete) and each text on
+ * its own (text=Delete). Its numbers are the fields listed in CorpusIndex::fieldNames. add may be called from several
+ * threads at once. Texts are kept as pointers until the index is written, so every descriptor added must have interned
+ * its texts in the same StringTable, which must outlive the builder.
+ */
+class CorpusIndexBuilder
+{
+private:
+
+    /**
+     * @brief What was collected from one file.
+     */
+    struct Entry
+    {
+        /// The path recorded for the file
+        std::string path;
+        /// The distinct terms of the file, other than those naming a text
+        std::vector<std::string> terms;
+        /// The distinct kinds and texts of the nodes holding a text
+        std::vector<std::pair<Token, const std::string *>> texts;
+        /// The field and value of each number in the file
+        std::vector<std::pair<uint32_t, int32_t>> values;
+    };
+
+    /// The files added so far
+    std::vector<Entry> entries;
+    /// Guards entries
+    std::mutex lock;
+
+public:
+
+    /**
+     * Adds the terms and numbers of a parsed file.
+     * @param path the path to record for the file
+     * @param descriptor the complete widget tree of the file
+     */
+    void add(const std::string &path, const Descriptor &descriptor);
+
+    /**
+     * Gets the number of files added.
+     * @return the count
+     */
+    size_t size();
+
+    /**
+     * Writes the index. Files are numbered in path order so the same corpus always gives the same index.
+     * @param filename the index file to write
+     * @return the number of distinct terms written
+     * @throw runtime_error if the file cannot be written
+     */
+    size_t write(std::experimental::filesystem::path filename) throw(std::runtime_error);
+};
+
+/**
+ * @brief A memory-mapped index which answers queries without parsing anything.
+ * @details A query is a list of clauses which must all hold for a file to match:\n
+ *  Kind - the file has such a node or layout, e.g. Button or Grid\n
+ *  Kind=Text - the file has such a node with that text, e.g. Button=Delete, or text=Delete for any kind\n
+ *  field OP number - the file has such a number, e.g. grid.columns>8; OP is one of = < <= > >=\n
+ */
+class CorpusIndex
+{
+private:
+    /// The mapped file
+    const char *data;
+    /// The size of the mapped file
+    size_t size;
+    /// The file contents when the platform cannot map files
+    std::vector<char> buffer;
+    /// The header at the start of data
+    const IndexHeader *header;
+    /// The files section
+    const IndexFile *files;
+    /// The terms section
+    const IndexTerm *terms;
+    /// The postings section
+    const uint32_t *postings;
+    /// The ranges section
+    const IndexRange *ranges;
+    /// The strings section
+    const char *strings;
+
+    /**
+     * Finds the files matching one clause.
+     * @param clause the clause
+     * @return the sorted file ids
+     * @throw runtime_error if the clause cannot be understood
+     */
+    std::vector<uint32_t> match(const std::string &clause) const throw(std::runtime_error);
+
+public:
+
+    /// The names of the numeric fields, in the order of IndexRange::field
+    static const std::vector<std::string> fieldNames;
+
+    /**
+     * CorpusIndex Constructor, maps an index file.
+     * @param filename the index file
+     * @return A CorpusIndex object
+     * @throw runtime_error if the file cannot be read or is not an index
+     */
+    explicit CorpusIndex(std::experimental::filesystem::path filename) throw(std::runtime_error);
+
+    /**
+     * CorpusIndex Destructor, unmaps the file.
+     */
+    ~CorpusIndex();
+
+    CorpusIndex(const CorpusIndex &) = delete;
+    CorpusIndex &operator=(const CorpusIndex &) = delete;
+
+    /**
+     * Finds the files matching every clause.
+     * @param clauses the clauses
+     * @return the paths of the matching files, sorted
+     * @throw runtime_error if a clause cannot be understood
+     */
+    std::vector<std::string> query(const std::vector<std::string> &clauses) const throw(std::runtime_error);
+
+    /**
+     * Gets the number of indexed files.
+     * @return the count
+     */
+    size_t fileCount() const;
+};
+
+#endif
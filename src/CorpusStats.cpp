@@ -0,0 +1,224 @@
+/**
+ * @file CorpusStats.cpp
+ * @brief Contains the source code for the CorpusStats class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <istream>
+#include <limits>
+
+#include "CorpusStats.h"
+
+using namespace std;
+
+/**
+ * Writes a list of values as its length followed by the values, each after a space.
+ * @param out the stream to write to
+ * @param values the values
+ */
+template<typename T>
+static void saveValues(ostream &out, const vector<T> &values) {
+    out << " " << values.size();
+    for (const T &value : values) {
+        out << " " << value;
+    }
+}
+
+/**
+ * Reads back a list of values written by saveValues.
+ * @param in the stream to read from
+ * @param values receives the values
+ * @return true if the list was read
+ */
+template<typename T>
+static bool loadValues(istream &in, vector<T> &values) {
+    size_t count = 0;
+    if (!(in >> count)) {
+        return false;
+    }
+    values.clear();
+    T value;
+    for (size_t i = 0; i < count && in >> value; ++i) {
+        values.push_back(value);
+    }
+    return values.size() == count;
+}
+
+/**
+ * Writes the 50th, 90th and 99th percentiles and the maximum of a set of values.
+ * @param out the stream to write to
+ * @param name what the values are
+ * @param values the values, reordered by this call
+ */
+template<typename T>
+static void writePercentiles(ostream &out, const char *name, vector<T> values) {
+    out << name << ":";
+    if (values.empty()) {
+        out << " none" << endl;
+        return;
+    }
+    const int percents[] = { 50, 90, 99 };
+    for (int percent : percents) {
+        // nearest rank, so every percentile is one of the values
+        size_t rank = (values.size() * percent + 99) / 100;
+        auto nth = values.begin() + (rank == 0 ? 0 : rank - 1);
+        std::nth_element(values.begin(), nth, values.end());
+        out << " p" << percent << " " << *nth << ",";
+    }
+    out << " max " << *std::max_element(values.begin(), values.end()) << endl;
+}
+
+CorpusStats::CorpusStats() :
+    files(0),
+    validFiles(0)
+{
+    std::fill(begin(kinds), end(kinds), 0);
+    std::fill(begin(layouts), end(layouts), 0);
+}
+
+void CorpusStats::addFile(const Descriptor &descriptor, bool valid, unsigned long long bytes, double parseMs) {
+    ++files;
+    fileSizes.push_back(bytes);
+    parseTimes.push_back(parseMs);
+    if (!valid) {
+        return;
+    }
+    ++validFiles;
+
+    const vector<DescriptorNode> &nodes = descriptor.getNodes();
+    // nodes are in pre-order, so a parent's depth is always known before its children's
+    vector<unsigned int> depths(nodes.size(), 0);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const DescriptorNode &node = nodes[i];
+        ++kinds[node.kind];
+        if (node.layout != NONE) {
+            ++layouts[node.layout];
+        }
+        if (node.layout == GRID && node.layoutParams.size() >= 2) {
+            ++gridSizes[make_pair(node.layoutParams[0], node.layoutParams[1])];
+        }
+        if (node.kind == WINDOW || node.kind == BUTTON || node.kind == LABEL || node.kind == RADIO) {
+            stringLengths.push_back(static_cast<unsigned int>(node.text->length()));
+        }
+        if (node.parent != i) {
+            depths[i] = depths[node.parent];
+        }
+        if (node.kind == PANEL) {
+            depths[i]++;
+            if (panelDepths.size() <= depths[i]) {
+                panelDepths.resize(depths[i] + 1, 0);
+            }
+            ++panelDepths[depths[i]];
+        }
+    }
+}
+
+void CorpusStats::merge(const CorpusStats &other) {
+    files += other.files;
+    validFiles += other.validFiles;
+    for (size_t i = 0; i <= COMMA; ++i) {
+        kinds[i] += other.kinds[i];
+        layouts[i] += other.layouts[i];
+    }
+    if (panelDepths.size() < other.panelDepths.size()) {
+        panelDepths.resize(other.panelDepths.size(), 0);
+    }
+    for (size_t i = 0; i < other.panelDepths.size(); ++i) {
+        panelDepths[i] += other.panelDepths[i];
+    }
+    for (const auto &gridSize : other.gridSizes) {
+        gridSizes[gridSize.first] += gridSize.second;
+    }
+    stringLengths.insert(stringLengths.end(), other.stringLengths.begin(), other.stringLengths.end());
+    fileSizes.insert(fileSizes.end(), other.fileSizes.begin(), other.fileSizes.end());
+    parseTimes.insert(parseTimes.end(), other.parseTimes.begin(), other.parseTimes.end());
+}
+
+void CorpusStats::write(std::ostream &out) const {
+    out << "Statistics: " << files << " files, " << validFiles << " valid" << endl;
+
+    const pair<Token, const char *> kindNames[] = {
+        { WINDOW, "Window" }, { PANEL, "Panel" }, { GROUP, "Group" }, { BUTTON, "Button" }, { LABEL, "Label" },
+        { TEXTFIELD, "Textfield" }, { RADIO, "Radio" }
+    };
+    out << "Widgets:";
+    for (const auto &kind : kindNames) {
+        out << " " << kind.second << " " << kinds[kind.first] << (kind.first == RADIO ? "" : ",");
+    }
+    out << endl;
+
+    out << "Layouts: Flow " << layouts[FLOW] << ", Border " << layouts[BORDER] << ", Grid " << layouts[GRID] << endl;
+
+    out << "Panel depth:";
+    if (panelDepths.size() <= 1) {
+        out << " none";
+    }
+    for (size_t depth = 1; depth < panelDepths.size(); ++depth) {
+        out << " " << depth << ": " << panelDepths[depth] << (depth + 1 == panelDepths.size() ? "" : ",");
+    }
+    out << endl;
+
+    out << "Grid sizes:";
+    if (gridSizes.empty()) {
+        out << " none";
+    }
+    for (auto gridSize = gridSizes.begin(); gridSize != gridSizes.end(); ++gridSize) {
+        out << (gridSize == gridSizes.begin() ? " " : ", ") << gridSize->first.first << "x" << gridSize->first.second
+            << ": " << gridSize->second;
+    }
+    out << endl;
+
+    writePercentiles(out, "String length", stringLengths);
+    writePercentiles(out, "File size (bytes)", fileSizes);
+    out << fixed << setprecision(3);
+    writePercentiles(out, "Parse time (ms)", parseTimes);
+    out << defaultfloat;
+}
+
+void CorpusStats::save(std::ostream &out) const {
+    out << files << " " << validFiles;
+    for (size_t i = 0; i <= COMMA; ++i) {
+        out << " " << kinds[i] << " " << layouts[i];
+    }
+    saveValues(out, panelDepths);
+    out << " " << gridSizes.size();
+    for (const auto &gridSize : gridSizes) {
+        out << " " << gridSize.first.first << " " << gridSize.first.second << " " << gridSize.second;
+    }
+    saveValues(out, stringLengths);
+    saveValues(out, fileSizes);
+    // enough digits for the times to read back exactly
+    streamsize precision = out.precision(numeric_limits<double>::max_digits10);
+    saveValues(out, parseTimes);
+    out.precision(precision);
+    out << "\n";
+}
+
+bool CorpusStats::load(std::istream &in) {
+    *this = CorpusStats();
+    if (!(in >> files >> validFiles)) {
+        return false;
+    }
+    for (size_t i = 0; i <= COMMA; ++i) {
+        if (!(in >> kinds[i] >> layouts[i])) {
+            return false;
+        }
+    }
+    size_t grids = 0;
+    if (!loadValues(in, panelDepths) || !(in >> grids)) {
+        return false;
+    }
+    for (size_t i = 0; i < grids; ++i) {
+        int rows = 0;
+        int columns = 0;
+        unsigned long long count = 0;
+        if (!(in >> rows >> columns >> count)) {
+            return false;
+        }
+        gridSizes[make_pair(rows, columns)] = count;
+    }
+    return loadValues(in, stringLengths) && loadValues(in, fileSizes) && loadValues(in, parseTimes);
+}
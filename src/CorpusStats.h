@@ -0,0 +1,90 @@
+/**
+ * @file CorpusStats.h
+ * @brief Contains the CorpusStats class definition, which summarises the files parsed in a run.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_CORPUSSTATS_H_H
+#define PROJECT1_CORPUSSTATS_H_H
+
+#pragma once
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Descriptor.h"
+
+/**
+ * @brief Counts widgets, layouts, nesting and sizes over many files.
+ * @details A CorpusStats is not thread safe. Each thread fills its own and they are merged once at the end, so
+ * collecting statistics adds no locking to a run.
+ */
+class CorpusStats
+{
+private:
+    /// Number of files added
+    unsigned long long files;
+    /// Number of files that parsed
+    unsigned long long validFiles;
+    /// Number of nodes of each kind, indexed by Token
+    unsigned long long kinds[COMMA + 1];
+    /// Number of Window and Panel layouts of each type, indexed by Token
+    unsigned long long layouts[COMMA + 1];
+    /// panelDepths[d] is the number of Panels inside d - 1 other Panels
+    std::vector<unsigned long long> panelDepths;
+    /// Number of Grid layouts with each rows and columns
+    std::map<std::pair<int, int>, unsigned long long> gridSizes;
+    /// Length of every Window, Button, Label and Radio text
+    std::vector<unsigned int> stringLengths;
+    /// Size of every file in bytes
+    std::vector<unsigned long long> fileSizes;
+    /// Time taken to parse every file in milliseconds
+    std::vector<double> parseTimes;
+
+public:
+
+    /**
+     * CorpusStats Constructor
+     * @return An empty CorpusStats
+     */
+    CorpusStats();
+
+    /**
+     * Adds a parsed file.
+     * @param descriptor the widget tree of the file, only counted when valid
+     * @param valid true if the file parsed
+     * @param bytes the size of the file
+     * @param parseMs the time taken to parse the file
+     */
+    void addFile(const Descriptor &descriptor, bool valid, unsigned long long bytes, double parseMs);
+
+    /**
+     * Adds the statistics of another CorpusStats to this one.
+     * @param other the statistics to add
+     */
+    void merge(const CorpusStats &other);
+
+    /**
+     * Writes the statistics on one line in a form load reads back, for passing them between processes.
+     * @param out the stream to write to
+     */
+    void save(std::ostream &out) const;
+
+    /**
+     * Replaces the statistics with ones written by save.
+     * @param in the stream to read from
+     * @return true if they were read, false if the input is malformed
+     */
+    bool load(std::istream &in);
+
+    /**
+     * Writes the report.
+     * @param out the stream to write to
+     */
+    void write(std::ostream &out) const;
+};
+
+#endif
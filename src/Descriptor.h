@@ -0,0 +1,219 @@
+/**
+ * @file Descriptor.h
+ * @brief Contains the Descriptor class definition, an in-memory widget tree built by the Parser.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_DESCRIPTOR_H_H
+#define PROJECT1_DESCRIPTOR_H_H
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Lexer.h"
+
+/**
+ * @brief A single Window, Panel, Group or widget of a parsed descriptor.
+ */
+struct DescriptorNode
+{
+    /// WINDOW, PANEL, GROUP, BUTTON, LABEL, TEXTFIELD or RADIO
+    Token kind;
+    /// FLOW, BORDER or GRID for a Window or Panel, NONE otherwise
+    Token layout;
+    /// LEFT, RIGHT or CENTER for an aligned Flow layout, NONE otherwise
+    Token align;
+    /// The Window title or the Button, Label or Radio text, stored in the StringTable the parser interned it in, so
+    /// two texts from the same table are equal exactly when the pointers are. Other nodes point at Descriptor::noText.
+    const std::string *text;
+    /// The Window width and height or the Textfield width
+    std::vector<int> numbers;
+    /// The numbers given to the layout type
+    std::vector<int> layoutParams;
+    /// Index of the enclosing node, the Window refers to itself
+    unsigned int parent;
+    /// Index one past the last node of this subtree
+    unsigned int end;
+    /// FNV-1a hash of this node and, in order, the hashes of its children, set when the node is ended. Two subtrees
+    /// with the same hash are taken to be the same.
+    uint64_t hash;
+};
+
+/**
+ * @brief The widget tree of a single file, stored in pre-order.
+ * @details Every node is followed by its descendants, so the subtree of node i occupies [i, nodes[i].end).
+ */
+class Descriptor
+{
+private:
+    /// All nodes in pre-order
+    std::vector<DescriptorNode> nodes;
+    /// Indexes of the nodes that have been started but not ended
+    std::vector<unsigned int> openNodes;
+
+    /**
+     * Mixes bytes into an FNV-1a hash.
+     * @param hash the hash so far
+     * @param data the bytes
+     * @param length the number of bytes
+     */
+    static void mix(uint64_t &hash, const void *data, size_t length)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+
+    /**
+     * Mixes an int into an FNV-1a hash.
+     * @param hash the hash so far
+     * @param value the value
+     */
+    static void mix(uint64_t &hash, int64_t value)
+    {
+        mix(hash, &value, sizeof(value));
+    }
+
+    /**
+     * Hashes a node whose children have already been hashed.
+     * @param index the node
+     * @return the hash
+     */
+    uint64_t hashNode(unsigned int index) const
+    {
+        const DescriptorNode &node = nodes[index];
+        uint64_t hash = 14695981039346656037ULL;
+        mix(hash, node.kind);
+        mix(hash, node.layout);
+        mix(hash, node.align);
+        // lengths keep neighbouring fields from running into each other
+        mix(hash, static_cast<int64_t>(node.text->length()));
+        mix(hash, node.text->data(), node.text->length());
+        mix(hash, static_cast<int64_t>(node.numbers.size()));
+        for (int number : node.numbers) {
+            mix(hash, number);
+        }
+        mix(hash, static_cast<int64_t>(node.layoutParams.size()));
+        for (int param : node.layoutParams) {
+            mix(hash, param);
+        }
+        for (unsigned int child = index + 1; child < node.end; child = nodes[child].end) {
+            mix(hash, static_cast<int64_t>(nodes[child].hash));
+        }
+        return hash;
+    }
+
+public:
+
+    /**
+     * Gets the empty text of the nodes which have none, which is not stored in any StringTable.
+     * @return the text
+     */
+    static const std::string &noText()
+    {
+        static const std::string empty;
+        return empty;
+    }
+
+    /**
+     * Starts a new node as a child of the innermost open node.
+     * @param kind the token which introduced the node
+     * @return the index of the new node
+     */
+    unsigned int beginNode(Token kind)
+    {
+        DescriptorNode node;
+        node.kind = kind;
+        node.layout = NONE;
+        node.align = NONE;
+        node.text = &noText();
+        node.parent = openNodes.empty() ? static_cast<unsigned int>(nodes.size()) : openNodes.back();
+        node.end = static_cast<unsigned int>(nodes.size()) + 1;
+        node.hash = 0;
+        nodes.push_back(node);
+        openNodes.push_back(static_cast<unsigned int>(nodes.size()) - 1);
+        return openNodes.back();
+    }
+
+    /**
+     * Closes the innermost open node once all of its children have been added.
+     */
+    void endNode()
+    {
+        nodes[openNodes.back()].end = static_cast<unsigned int>(nodes.size());
+        nodes[openNodes.back()].hash = hashNode(openNodes.back());
+        openNodes.pop_back();
+    }
+
+    /**
+     * Adds a complete tree recorded separately, such as a Panel parsed on another thread, as the next child of the
+     * innermost open node.
+     * @param subtree a complete descriptor whose root becomes the child
+     */
+    void splice(const Descriptor &subtree)
+    {
+        unsigned int base = static_cast<unsigned int>(nodes.size());
+        for (const DescriptorNode &node : subtree.nodes) {
+            nodes.push_back(node);
+            DescriptorNode &added = nodes.back();
+            added.parent = &node == &subtree.nodes.front() ? openNodes.back() : node.parent + base;
+            added.end = node.end + base;
+        }
+    }
+
+    /**
+     * Gets how many nodes are open, i.e. the nesting depth of the next node's parent.
+     * @return the number of open nodes
+     */
+    unsigned int depth() const
+    {
+        return static_cast<unsigned int>(openNodes.size());
+    }
+
+    /**
+     * Gets the innermost open node.
+     * @return the node
+     */
+    DescriptorNode &current()
+    {
+        return nodes[openNodes.back()];
+    }
+
+    /**
+     * Gets all nodes in pre-order.
+     * @return the nodes
+     */
+    const std::vector<DescriptorNode> &getNodes() const
+    {
+        return nodes;
+    }
+
+    /**
+     * Gets the indexes of the children of a node.
+     * @param index the node
+     * @return the children in order
+     */
+    std::vector<unsigned int> children(unsigned int index) const
+    {
+        std::vector<unsigned int> result;
+        for (unsigned int child = index + 1; child < nodes[index].end; child = nodes[child].end) {
+            result.push_back(child);
+        }
+        return result;
+    }
+
+    /**
+     * Checks that a complete tree was recorded.
+     * @return true if there is a root and every node has been ended
+     */
+    bool isComplete() const
+    {
+        return !nodes.empty() && openNodes.empty();
+    }
+};
+
+#endif
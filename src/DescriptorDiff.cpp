@@ -0,0 +1,251 @@
+/**
+ * @file DescriptorDiff.cpp
+ * @brief Contains the source code for the DescriptorDiff class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <functional>
+
+#include "DescriptorDiff.h"
+
+using namespace std;
+
+/// The most old by new pairs of children worth lining up by longest common subsequence
+static const size_t maxAlignCells = 1 << 20;
+
+/**
+ * Builds the path of a child.
+ * @param path the path of its parent
+ * @param kind the kind of the child
+ * @param position the position of the child among its siblings, from 0
+ * @return the path, e.g. Window/Panel[2]
+ */
+static string childPath(const string &path, Token kind, size_t position) {
+    return path + "/" + DescriptorDiff::kindName(kind) + "[" + to_string(position + 1) + "]";
+}
+
+/**
+ * Lines up two sequences so that the total score of the pairs is as high as possible, keeping their order; with a
+ * score of 1 for equal elements this is the longest common subsequence. Sequences too long to line up within
+ * maxAlignCells are only lined up where elements at the same position can pair.
+ * @param rows the length of the first sequence
+ * @param columns the length of the second sequence
+ * @param score how well an element of the first sequence pairs with one of the second, 0 if they cannot pair
+ * @return the positions of the paired elements, in order
+ */
+static vector<pair<size_t, size_t>> align(size_t rows, size_t columns,
+                                          const function<unsigned int(size_t, size_t)> &score) {
+    vector<pair<size_t, size_t>> matches;
+    if (rows * columns > maxAlignCells) {
+        for (size_t i = 0; i < rows && i < columns; ++i) {
+            if (score(i, i) > 0) {
+                matches.push_back(make_pair(i, i));
+            }
+        }
+        return matches;
+    }
+    // scores[r][c] is the score of each pair, and best[r][c] the best total for the suffixes starting at r and c
+    vector<unsigned int> scores(rows * columns);
+    vector<unsigned int> best((rows + 1) * (columns + 1), 0);
+    for (size_t r = rows; r-- > 0;) {
+        for (size_t c = columns; c-- > 0;) {
+            unsigned int pairing = scores[r * columns + c] = score(r, c);
+            unsigned int &cell = best[r * (columns + 1) + c];
+            cell = std::max(best[(r + 1) * (columns + 1) + c], best[r * (columns + 1) + c + 1]);
+            if (pairing > 0) {
+                cell = std::max(cell, best[(r + 1) * (columns + 1) + c + 1] + pairing);
+            }
+        }
+    }
+    for (size_t r = 0, c = 0; r < rows && c < columns;) {
+        unsigned int pairing = scores[r * columns + c];
+        if (pairing > 0 && best[r * (columns + 1) + c] == best[(r + 1) * (columns + 1) + c + 1] + pairing) {
+            matches.push_back(make_pair(r++, c++));
+        }
+        else if (best[(r + 1) * (columns + 1) + c] >= best[r * (columns + 1) + c + 1]) {
+            ++r;
+        }
+        else {
+            ++c;
+        }
+    }
+    return matches;
+}
+
+/// The most children of each node looked at for shared subtrees when scoring a pair of nodes
+static const size_t maxScoredChildren = 16;
+
+/**
+ * Scores how alike two nodes are, for lining up children that changed.
+ * @param before the old version
+ * @param oldIndex the node in the old version
+ * @param after the new version
+ * @param newIndex the node in the new version
+ * @return 0 if the kinds differ, otherwise 1 plus 2 for each of the text, numbers and layout that are the same and
+ * 2 if the nodes still share a child subtree
+ */
+static unsigned int similarity(const Descriptor &before, unsigned int oldIndex, const Descriptor &after,
+                               unsigned int newIndex) {
+    const vector<DescriptorNode> &oldNodes = before.getNodes();
+    const vector<DescriptorNode> &newNodes = after.getNodes();
+    const DescriptorNode &oldNode = oldNodes[oldIndex];
+    const DescriptorNode &newNode = newNodes[newIndex];
+    if (oldNode.kind != newNode.kind) {
+        return 0;
+    }
+    unsigned int score = 1;
+    score += oldNode.text == newNode.text ? 2 : 0;
+    score += oldNode.numbers == newNode.numbers ? 2 : 0;
+    score += oldNode.layout == newNode.layout && oldNode.align == newNode.align
+        && oldNode.layoutParams == newNode.layoutParams ? 2 : 0;
+    // the first few children of each are enough to tell an edited container from an unrelated one
+    size_t oldSeen = 0;
+    for (unsigned int o = oldIndex + 1; o < oldNode.end && oldSeen < maxScoredChildren; o = oldNodes[o].end) {
+        size_t newSeen = 0;
+        for (unsigned int n = newIndex + 1; n < newNode.end && newSeen < maxScoredChildren; n = newNodes[n].end) {
+            if (oldNodes[o].hash == newNodes[n].hash) {
+                return score + 2;
+            }
+            ++newSeen;
+        }
+        ++oldSeen;
+    }
+    return score;
+}
+
+DescriptorDiff::DescriptorDiff(const Descriptor &oldDescriptor, const Descriptor &newDescriptor) :
+    before(oldDescriptor),
+    after(newDescriptor)
+{
+}
+
+const char *DescriptorDiff::kindName(Token kind) {
+    switch (kind) {
+        case WINDOW: return "Window";
+        case PANEL: return "Panel";
+        case GROUP: return "Group";
+        case BUTTON: return "Button";
+        case LABEL: return "Label";
+        case TEXTFIELD: return "Textfield";
+        case RADIO: return "Radio";
+        default: return "?";
+    }
+}
+
+std::string DescriptorDiff::describe(const DescriptorNode &node) {
+    string description(kindName(node.kind));
+    if (node.kind == WINDOW || node.kind == BUTTON || node.kind == LABEL || node.kind == RADIO) {
+        description += " \"" + *node.text + "\"";
+    }
+    if (node.kind == WINDOW && node.numbers.size() == 2) {
+        description += " (" + to_string(node.numbers[0]) + ", " + to_string(node.numbers[1]) + ")";
+    }
+    else if (node.kind == TEXTFIELD && !node.numbers.empty()) {
+        description += " " + to_string(node.numbers[0]);
+    }
+    if (node.layout != NONE) {
+        description += node.layout == FLOW ? " Flow(" : node.layout == BORDER ? " Border(" : " Grid(";
+        if (node.align != NONE) {
+            description += node.align == LEFT ? "LEFT" : node.align == RIGHT ? "RIGHT" : "CENTER";
+        }
+        for (size_t i = 0; i < node.layoutParams.size(); ++i) {
+            description += (i == 0 ? "" : ", ") + to_string(node.layoutParams[i]);
+        }
+        description += ")";
+    }
+    return description;
+}
+
+void DescriptorDiff::record(DiffChange change, const std::string &path, unsigned int oldIndex, unsigned int newIndex) {
+    DiffEntry entry;
+    entry.change = change;
+    entry.path = path;
+    if (change != ADDED) {
+        entry.before = describe(before.getNodes()[oldIndex]);
+    }
+    if (change != REMOVED) {
+        entry.after = describe(after.getNodes()[newIndex]);
+    }
+    entries.push_back(std::move(entry));
+}
+
+void DescriptorDiff::compareNodes(unsigned int oldIndex, unsigned int newIndex, const std::string &path) {
+    const DescriptorNode &oldNode = before.getNodes()[oldIndex];
+    const DescriptorNode &newNode = after.getNodes()[newIndex];
+    if (oldNode.layout != newNode.layout || oldNode.align != newNode.align || oldNode.text != newNode.text
+        || oldNode.numbers != newNode.numbers || oldNode.layoutParams != newNode.layoutParams) {
+        record(CHANGED, path, oldIndex, newIndex);
+    }
+    // the hash also covers the children, so if the node itself is unchanged they must differ
+    if (oldNode.end > oldIndex + 1 || newNode.end > newIndex + 1) {
+        compareChildren(oldIndex, newIndex, path);
+    }
+}
+
+void DescriptorDiff::compareChildren(unsigned int oldIndex, unsigned int newIndex, const std::string &path) {
+    const vector<DescriptorNode> &oldNodes = before.getNodes();
+    const vector<DescriptorNode> &newNodes = after.getNodes();
+    vector<unsigned int> oldChildren(before.children(oldIndex));
+    vector<unsigned int> newChildren(after.children(newIndex));
+
+    // children which are the same at either end are skipped by hash alone
+    size_t first = 0;
+    while (first < oldChildren.size() && first < newChildren.size()
+           && oldNodes[oldChildren[first]].hash == newNodes[newChildren[first]].hash) {
+        ++first;
+    }
+    size_t oldEnd = oldChildren.size();
+    size_t newEnd = newChildren.size();
+    while (oldEnd > first && newEnd > first
+           && oldNodes[oldChildren[oldEnd - 1]].hash == newNodes[newChildren[newEnd - 1]].hash) {
+        --oldEnd;
+        --newEnd;
+    }
+
+    // line up the rest by hash to find the unchanged ones, then add a sentinel match at the end
+    vector<pair<size_t, size_t>> unchanged(align(oldEnd - first, newEnd - first, [&](size_t o, size_t n) {
+        return oldNodes[oldChildren[first + o]].hash == newNodes[newChildren[first + n]].hash ? 1u : 0u;
+    }));
+    unchanged.push_back(make_pair(oldEnd - first, newEnd - first));
+
+    // between unchanged children, line up the others of the same kind by how alike they are; those lined up are
+    // compared in turn and the rest were added or removed
+    size_t oldGap = first;
+    size_t newGap = first;
+    for (const pair<size_t, size_t> &match : unchanged) {
+        size_t oldStop = first + match.first;
+        size_t newStop = first + match.second;
+        vector<pair<size_t, size_t>> sameKind(align(oldStop - oldGap, newStop - newGap, [&](size_t o, size_t n) {
+            return similarity(before, oldChildren[oldGap + o], after, newChildren[newGap + n]);
+        }));
+        sameKind.push_back(make_pair(oldStop - oldGap, newStop - newGap));
+        size_t o = oldGap;
+        size_t n = newGap;
+        for (const pair<size_t, size_t> &pairing : sameKind) {
+            for (; o < oldGap + pairing.first; ++o) {
+                record(REMOVED, childPath(path, oldNodes[oldChildren[o]].kind, o), oldChildren[o], 0);
+            }
+            for (; n < newGap + pairing.second; ++n) {
+                record(ADDED, childPath(path, newNodes[newChildren[n]].kind, n), 0, newChildren[n]);
+            }
+            if (o < oldStop && n < newStop) {
+                compareNodes(oldChildren[o], newChildren[n], childPath(path, newNodes[newChildren[n]].kind, n));
+                ++o;
+                ++n;
+            }
+        }
+        oldGap = oldStop + 1;
+        newGap = newStop + 1;
+    }
+}
+
+const std::vector<DiffEntry> &DescriptorDiff::compare() {
+    entries.clear();
+    const vector<DescriptorNode> &oldNodes = before.getNodes();
+    const vector<DescriptorNode> &newNodes = after.getNodes();
+    if (oldNodes[0].hash != newNodes[0].hash) {
+        compareNodes(0, 0, "Window");
+    }
+    return entries;
+}
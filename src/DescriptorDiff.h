@@ -0,0 +1,117 @@
+/**
+ * @file DescriptorDiff.h
+ * @brief Contains the DescriptorDiff class definition, which finds the widgets that differ between two descriptors.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_DESCRIPTORDIFF_H_H
+#define PROJECT1_DESCRIPTORDIFF_H_H
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Descriptor.h"
+
+/**
+ * @brief How a widget differs between two versions of a file.
+ */
+enum DiffChange
+{
+    ADDED, REMOVED, CHANGED
+};
+
+/**
+ * @brief One difference between two versions of a file.
+ */
+struct DiffEntry
+{
+    /// What happened to the widget
+    DiffChange change;
+    /// Where the widget is, such as Window/Panel[2]/Button[3], numbering a removed widget by its place in the old file
+    std::string path;
+    /// The widget in the old file, empty if it was added
+    std::string before;
+    /// The widget in the new file, empty if it was removed
+    std::string after;
+};
+
+/**
+ * @brief Compares two complete descriptors using their subtree hashes.
+ * @details Subtrees with equal hashes are skipped without being looked at, and matching children at either end of a
+ * child list are skipped by hash alone, so the work grows with the size of the change rather than the size of the
+ * files. Children that are left over are lined up by a longest common subsequence of their hashes to find the
+ * unchanged ones. Those in between are lined up with children of the same kind, preferring pairs whose text, numbers
+ * and layout are the same or which still share a child subtree; children lined up are compared in turn and the rest
+ * are reported as added or removed. Comparing recurses once per level of nesting, so
+ * the descriptors should come from parses with a depth limit. Texts are compared by address, so both descriptors
+ * must have interned their texts in the same StringTable.
+ */
+class DescriptorDiff
+{
+private:
+    /// The old version
+    const Descriptor &before;
+    /// The new version
+    const Descriptor &after;
+    /// The differences found so far
+    std::vector<DiffEntry> entries;
+
+    /**
+     * Compares a node of each version whose hashes differ.
+     * @param oldIndex the node in the old version
+     * @param newIndex the node in the new version
+     * @param path the path of the node in the new version
+     */
+    void compareNodes(unsigned int oldIndex, unsigned int newIndex, const std::string &path);
+
+    /**
+     * Compares the children of two nodes.
+     * @param oldIndex the parent in the old version
+     * @param newIndex the parent in the new version
+     * @param path the path of the parent in the new version
+     */
+    void compareChildren(unsigned int oldIndex, unsigned int newIndex, const std::string &path);
+
+    /**
+     * Records a difference.
+     * @param change what happened to the widget
+     * @param path where the widget is
+     * @param oldIndex the widget in the old version, ignored when added
+     * @param newIndex the widget in the new version, ignored when removed
+     */
+    void record(DiffChange change, const std::string &path, unsigned int oldIndex, unsigned int newIndex);
+
+public:
+
+    /**
+     * DescriptorDiff Constructor
+     * @param oldDescriptor the old version, which must be complete
+     * @param newDescriptor the new version, which must be complete
+     * @return A DescriptorDiff object
+     */
+    DescriptorDiff(const Descriptor &oldDescriptor, const Descriptor &newDescriptor);
+
+    /**
+     * Compares the two versions.
+     * @return the differences in the order of the new file, empty if the files are the same
+     */
+    const std::vector<DiffEntry> &compare();
+
+    /**
+     * Describes a node without its children, e.g. Button "OK" or Panel Grid(4, 3).
+     * @param node the node
+     * @return the description
+     */
+    static std::string describe(const DescriptorNode &node);
+
+    /**
+     * Gets the name of a kind of node.
+     * @param kind WINDOW, PANEL, GROUP, BUTTON, LABEL, TEXTFIELD or RADIO
+     * @return the name as written in a file, e.g. Button
+     */
+    static const char *kindName(Token kind);
+};
+
+#endif
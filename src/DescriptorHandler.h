@@ -0,0 +1,99 @@
+/**
+ * @file DescriptorHandler.h
+ * @brief Contains the DescriptorHandler class, which records the widget tree of a parse.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_DESCRIPTORHANDLER_H_H
+#define PROJECT1_DESCRIPTORHANDLER_H_H
+
+#pragma once
+
+#include "Descriptor.h"
+#include "ParseHandler.h"
+#include "StringTable.h"
+
+/**
+ * @brief Records the events of a parse as a Descriptor. The descriptor is only complete when the file is valid.
+ */
+class DescriptorHandler : public ParseHandler
+{
+private:
+    /// Holds the texts the nodes point at
+    StringTable &strings;
+
+public:
+    /// The widget tree recorded so far
+    Descriptor descriptor;
+
+    /**
+     * DescriptorHandler Constructor
+     * @param table the table the texts are interned in, which must outlive the descriptor
+     * @return A DescriptorHandler object
+     */
+    explicit DescriptorHandler(StringTable &table) :
+        strings(table)
+    {
+    }
+
+    void onWindow(const std::string &text, int width, int height)
+    {
+        descriptor.beginNode(WINDOW);
+        DescriptorNode &node = descriptor.current();
+        node.text = &strings.intern(text);
+        node.numbers.push_back(width);
+        node.numbers.push_back(height);
+    }
+
+    void onLayout(Token kind, Token align, const std::vector<int> &params)
+    {
+        DescriptorNode &node = descriptor.current();
+        node.layout = kind;
+        node.align = align;
+        node.layoutParams = params;
+    }
+
+    void onPanelBegin()
+    {
+        descriptor.beginNode(PANEL);
+    }
+
+    void onPanelEnd()
+    {
+        descriptor.endNode();
+    }
+
+    void onGroupBegin()
+    {
+        descriptor.beginNode(GROUP);
+    }
+
+    void onGroupEnd()
+    {
+        descriptor.endNode();
+    }
+
+    void onWidget(Token kind, const std::string &text, int number)
+    {
+        descriptor.beginNode(kind);
+        DescriptorNode &node = descriptor.current();
+        if (kind == TEXTFIELD) {
+            node.numbers.push_back(number);
+        }
+        else {
+            node.text = &strings.intern(text);
+        }
+        descriptor.endNode();
+    }
+
+    void onWindowEnd()
+    {
+        // the grammar lets a widget list stop at a production that failed, leaving the Panels and Groups it had
+        // begun open; they end with the Window
+        while (descriptor.depth() > 0) {
+            descriptor.endNode();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file DiffCommand.cpp
+ * @brief Contains the source code for the diff command of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BasicParser.h"
+#include "DescriptorDiff.h"
+#include "DescriptorHandler.h"
+#include "DiffCommand.h"
+#include "Lexer.h"
+#include "StringTable.h"
+
+using namespace std;
+
+/**
+ * Parses a file for the diff command, which only needs its descriptor, so no trace is written.
+ * @param fileName the file
+ * @param strings the table the texts of the descriptor are interned in, shared by both versions
+ * @return the descriptor
+ * @throw runtime_error if the file cannot be read, does not parse or exceeds the default limits
+ */
+static Descriptor parse_for_diff(const string &fileName, StringTable &strings) throw(runtime_error) {
+    ifstream in(fileName, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Invalid path to input file " + fileName);
+    }
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    Lexer lexer(std::experimental::filesystem::path(fileName), std::move(contents));
+    DescriptorHandler tree(strings);
+    BasicParser<DescriptorHandler> parser(lexer, tree);
+    // the default nesting limit also bounds the recursion of the diff, which descends once per level
+    lexer.setLimits(ParseLimits::defaults(), chrono::steady_clock::now());
+    if (!parser.file()) {
+        throw runtime_error(lexer.isLimitReached() ? "Stopped " + fileName + ": " + lexer.getDiagnostic()
+                                                   : fileName + " does not parse");
+    }
+    return std::move(tree.descriptor);
+}
+
+int run_diff(int argc, char *argv[]) {
+    if (argc != 4) {
+        cout << "diff requires an old and a new file" << endl;
+        return 2;
+    }
+    try {
+        StringTable strings;
+        Descriptor before(parse_for_diff(argv[2], strings));
+        Descriptor after(parse_for_diff(argv[3], strings));
+        auto start = chrono::steady_clock::now();
+        DescriptorDiff diff(before, after);
+        const vector<DiffEntry> &entries = diff.compare();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        for (const DiffEntry &entry : entries) {
+            if (entry.change == ADDED) {
+                cout << "added   " << entry.path << ": " << entry.after << "\n";
+            }
+            else if (entry.change == REMOVED) {
+                cout << "removed " << entry.path << ": " << entry.before << "\n";
+            }
+            else {
+                cout << "changed " << entry.path << ": " << entry.before << " -> " << entry.after << "\n";
+            }
+        }
+        cout << entries.size() << " differences found in " << fixed << setprecision(3) << elapsed.count() << " ms"
+            << endl;
+        return entries.empty() ? 0 : 1;
+    }
+    catch (runtime_error &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 2;
+    }
+}
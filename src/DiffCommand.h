@@ -0,0 +1,20 @@
+/**
+ * @file DiffCommand.h
+ * @brief Contains the diff command of the driver, which compares the widget trees of two versions of a file.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_DIFFCOMMAND_H_H
+#define PROJECT1_DIFFCOMMAND_H_H
+
+#pragma once
+
+/**
+ * Runs the diff command: prints the widgets that differ between two versions of a file.
+ * @param argc number of arguments
+ * @param argv the arguments, argv[2] is the old version and argv[3] the new one
+ * @return 0 if they are the same, 1 if they differ, 2 if either cannot be parsed
+ */
+int run_diff(int argc, char *argv[]);
+
+#endif //PROJECT1_DIFFCOMMAND_H_H
@@ -0,0 +1,195 @@
+/**
+ * @file DirectoryWatcher.cpp
+ * @brief Contains the source code for the DirectoryWatcher class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "DirectoryWatcher.h"
+
+using namespace std;
+
+namespace fs = std::experimental::filesystem;
+
+#ifdef __linux__
+
+/// The events which mean a file has new contents, or a directory has appeared
+static const uint32_t watchedEvents = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+DirectoryWatcher::DirectoryWatcher(std::experimental::filesystem::path dir, unsigned int debounce)
+    throw(runtime_error) :
+    directory(dir),
+    descriptor(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+    debounceMs(debounce)
+{
+    if (descriptor < 0) {
+        throw runtime_error(string("Cannot watch input directory: ") + strerror(errno));
+    }
+    if (!fs::is_directory(directory)) {
+        close(descriptor);
+        throw runtime_error("Invalid path to input directory");
+    }
+    addWatches(fs::path(), nullptr);
+    if (watches.empty()) {
+        close(descriptor);
+        throw runtime_error(problems.empty() ? string("Invalid path to input directory") : problems.front());
+    }
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    close(descriptor);
+}
+
+void DirectoryWatcher::addWatches(const std::experimental::filesystem::path &relative,
+                                  std::set<std::experimental::filesystem::path> *changed) {
+    fs::path full(relative.empty() ? directory : directory / relative);
+    int watch = inotify_add_watch(descriptor, full.c_str(), watchedEvents);
+    if (watch < 0) {
+        // a directory removed again before its watch was added has nothing left to watch; anything else, such as
+        // running out of watches, only costs this directory and those below it
+        if (errno != ENOENT) {
+            problems.push_back("Cannot watch " + full.string() + ": " + strerror(errno));
+        }
+        return;
+    }
+    watches[watch] = relative;
+
+    error_code error;
+    for (fs::directory_iterator entries(full, error); !error && entries != fs::directory_iterator();
+         entries.increment(error)) {
+        fs::path child(relative / entries->path().filename());
+        if (fs::is_directory(entries->status())) {
+            addWatches(child, changed);
+        }
+        else if (changed != nullptr && fs::is_regular_file(entries->status())) {
+            // the directory was created or moved in before its watch existed, so report what it already holds
+            changed->insert(child);
+        }
+    }
+}
+
+void DirectoryWatcher::readEvents(std::set<std::experimental::filesystem::path> &changed) throw(runtime_error) {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(descriptor, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Cannot read directory changes: ") + strerror(errno));
+        }
+        for (char *position = buffer; position < buffer + length; ) {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(position);
+            position += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // events were dropped, maybe including new directories, so look at the whole tree again and treat
+                // every file as changed; watches already in place are simply found again
+                addWatches(fs::path(), &changed);
+                continue;
+            }
+            auto watch = watches.find(event->wd);
+            if (watch == watches.end()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                // the directory was removed
+                watches.erase(watch);
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+            fs::path relative(watch->second / event->name);
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addWatches(relative, &changed);
+                }
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                changed.insert(relative);
+            }
+        }
+    }
+}
+
+std::vector<std::experimental::filesystem::path> DirectoryWatcher::wait() throw(runtime_error) {
+    set<fs::path> changed;
+    pollfd waiting;
+    waiting.fd = descriptor;
+    waiting.events = POLLIN;
+    while (true) {
+        // block for the first change, then keep collecting until the writes go quiet
+        int timeout = changed.empty() ? -1 : static_cast<int>(debounceMs);
+        int ready = poll(&waiting, 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Cannot wait for directory changes: ") + strerror(errno));
+        }
+        if (ready == 0) {
+            vector<fs::path> files;
+            for (const fs::path &relative : changed) {
+                // skip editor temporaries which were renamed or deleted straight after being written
+                if (fs::is_regular_file(directory / relative)) {
+                    files.push_back(relative);
+                }
+            }
+            if (!files.empty() || !problems.empty()) {
+                return files;
+            }
+            changed.clear();
+            continue;
+        }
+        readEvents(changed);
+    }
+}
+
+#else
+
+DirectoryWatcher::DirectoryWatcher(std::experimental::filesystem::path dir, unsigned int debounce)
+    throw(runtime_error) :
+    directory(dir),
+    descriptor(-1),
+    debounceMs(debounce)
+{
+    throw runtime_error("--watch is only supported on Linux");
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+}
+
+void DirectoryWatcher::addWatches(const std::experimental::filesystem::path &,
+                                  std::set<std::experimental::filesystem::path> *) {
+}
+
+void DirectoryWatcher::readEvents(std::set<std::experimental::filesystem::path> &) throw(runtime_error) {
+}
+
+std::vector<std::experimental::filesystem::path> DirectoryWatcher::wait() throw(runtime_error) {
+    return std::vector<std::experimental::filesystem::path>();
+}
+
+#endif
+
+std::vector<std::string> DirectoryWatcher::takeProblems() {
+    vector<string> taken;
+    taken.swap(problems);
+    return taken;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file DirectoryWatcher.h
+ * @brief Contains the DirectoryWatcher class definition, which reports files that are written under a directory.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_DIRECTORYWATCHER_H_H
+#define PROJECT1_DIRECTORYWATCHER_H_H
+
+#pragma once
+
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Waits for files under a directory, and any directories below it, to be written.
+ * @details Uses inotify, so it is only available on Linux. A file counts as changed once it is closed after writing
+ * or moved into the tree, which is how editors save. Changes arriving within the debounce interval of each other are
+ * collected into one batch so a burst of saves is only reported once. If the kernel's event queue overflows, the
+ * whole tree is scanned again and every file in it is reported as changed, since there is no telling which were.
+ * A directory which cannot be watched, for example once the user's inotify watches run out, is left out along with
+ * everything below it and the rest of the tree is still watched; the reasons are kept until takeProblems is called.
+ */
+class DirectoryWatcher
+{
+private:
+    /// The directory being watched
+    std::experimental::filesystem::path directory;
+    /// The inotify descriptor
+    int descriptor;
+    /// Maps each inotify watch to its directory, relative to directory
+    std::map<int, std::experimental::filesystem::path> watches;
+    /// How long to wait for further changes before reporting a batch
+    unsigned int debounceMs;
+    /// Why directories could not be watched, since takeProblems was last called
+    std::vector<std::string> problems;
+
+    /**
+     * Watches a directory and every directory below it. Directories which are gone by the time they are watched
+     * are skipped, and why any other cannot be watched is added to problems.
+     * @param relative the directory relative to the watched one
+     * @param changed receives the files already in the directory, for directories which appear while watching and
+     * for a rescan after lost events
+     */
+    void addWatches(const std::experimental::filesystem::path &relative,
+                    std::set<std::experimental::filesystem::path> *changed);
+
+    /**
+     * Reads the events that are waiting without blocking.
+     * @param changed receives the files that changed
+     * @throw runtime_error if the events cannot be read
+     */
+    void readEvents(std::set<std::experimental::filesystem::path> &changed) throw(std::runtime_error);
+
+public:
+
+    /**
+     * DirectoryWatcher Constructor, starts watching.
+     * @param directory the directory to watch
+     * @param debounceMs how long to wait for further changes before reporting a batch
+     * @return A DirectoryWatcher object
+     * @throw runtime_error if the directory itself cannot be watched or the platform has no inotify
+     */
+    DirectoryWatcher(std::experimental::filesystem::path directory, unsigned int debounceMs)
+        throw(std::runtime_error);
+
+    /**
+     * DirectoryWatcher Destructor, stops watching.
+     */
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher &) = delete;
+    DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+    /**
+     * Blocks until at least one file changes, or a new directory cannot be watched, and no more changes follow within
+     * the debounce interval.
+     * @return the changed files relative to the watched directory, sorted
+     * @throw runtime_error if the events cannot be read
+     */
+    std::vector<std::experimental::filesystem::path> wait() throw(std::runtime_error);
+
+    /**
+     * Hands over why directories could not be watched since the last call.
+     * @return one message per directory
+     */
+    std::vector<std::string> takeProblems();
+};
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file FileLoader.cpp
+ * @brief Contains the source code for the FileLoader class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include "FileLoader.h"
+#include "stringhelper.h"
+
+using namespace std;
+
+namespace fs = std::experimental::filesystem;
+
+bool FileLoader::selects(const std::experimental::filesystem::path &relative, const std::vector<std::string> &includes,
+                         const std::vector<std::string> &excludes) {
+    string name(relative.filename().string());
+    string path(relative.generic_string());
+    auto matches = [&](const string &pattern) {
+        return StringHelper::globMatch(pattern, pattern.find('/') == string::npos ? name : path);
+    };
+    if (!includes.empty() && std::none_of(includes.begin(), includes.end(), matches)) {
+        return false;
+    }
+    return std::none_of(excludes.begin(), excludes.end(), matches);
+}
+
+std::vector<LoadedFile> FileLoader::find(std::experimental::filesystem::path directory,
+                                         const std::vector<std::string> &includes,
+                                         const std::vector<std::string> &excludes) throw(runtime_error) {
+    vector<LoadedFile> found;
+    error_code error;
+    fs::recursive_directory_iterator entries(directory, error);
+    if (error) {
+        throw runtime_error("Invalid path to input directory");
+    }
+    for (; entries != fs::recursive_directory_iterator(); entries.increment(error)) {
+        if (error) {
+            throw runtime_error("Cannot search input directory: " + error.message());
+        }
+        if (!fs::is_regular_file(entries->status())) {
+            continue;
+        }
+        fs::path relative(entries->path().string().substr(directory.string().length()));
+        if (relative.has_root_directory()) {
+            relative = relative.relative_path();
+        }
+        if (selects(relative, includes, excludes)) {
+            LoadedFile file;
+            file.bytes = 0;
+            file.path = entries->path();
+            file.relative = relative;
+            found.push_back(file);
+        }
+    }
+    // directory order is arbitrary, sort so runs are repeatable
+    std::sort(found.begin(), found.end(), [](const LoadedFile &a, const LoadedFile &b) {
+        return a.relative.generic_string() < b.relative.generic_string();
+    });
+    return found;
+}
+
+FileLoader::FileLoader(std::experimental::filesystem::path directory, const std::vector<std::string> &includes,
+                       const std::vector<std::string> &excludes, unsigned int readerCount, unsigned int prefetch,
+                       unsigned int maxBytesval) throw(runtime_error) :
+    FileLoader(find(directory, includes, excludes), readerCount, prefetch, maxBytesval)
+{
+}
+
+FileLoader::FileLoader(std::vector<LoadedFile> files, unsigned int readerCount, unsigned int prefetch,
+                       unsigned int maxBytesval) :
+    pending(std::move(files)),
+    nextPending(0),
+    capacity(std::max(1u, prefetch)),
+    maxBytes(maxBytesval),
+    handedOut(0),
+    stopping(false)
+{
+    for (unsigned int i = 0; i < std::max(1u, readerCount); ++i) {
+        readers.emplace_back(&FileLoader::read, this);
+    }
+}
+
+FileLoader::~FileLoader()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    fileTaken.notify_all();
+    for (thread &reader : readers) {
+        reader.join();
+    }
+}
+
+void FileLoader::read()
+{
+    for (size_t i = nextPending++; i < pending.size(); i = nextPending++) {
+        LoadedFile file;
+        file.path = pending[i].path;
+        file.relative = pending[i].relative;
+        file.bytes = 0;
+        ifstream in(file.path, ios::binary);
+        if (in.is_open()) {
+            // read in one call when the size is known, so the contents are allocated exactly once
+            error_code sizeError;
+            uintmax_t size = fs::file_size(file.path, sizeError);
+            try {
+                if (!sizeError && maxBytes && size > maxBytes) {
+                    // the parser stops it on its size alone, so do not spend the memory on it
+                    file.bytes = size;
+                }
+                else if (!sizeError) {
+                    file.contents.resize(static_cast<size_t>(size));
+                    in.read(&file.contents[0], static_cast<streamsize>(size));
+                    file.contents.resize(static_cast<size_t>(in.gcount()));
+                    file.bytes = file.contents.size();
+                }
+                else {
+                    file.contents.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+                    file.bytes = file.contents.size();
+                }
+            }
+            catch (exception &e) {
+                file.error = e.what();
+            }
+        }
+        else {
+            file.error = "Invalid path to input file";
+        }
+
+        // the file next hands out is always within the window, so its reader never waits here
+        unique_lock<mutex> guard(lock);
+        fileTaken.wait(guard, [this, i] { return i < handedOut + capacity || stopping; });
+        if (stopping) {
+            return;
+        }
+        loaded.emplace(i, std::move(file));
+        guard.unlock();
+        fileLoaded.notify_all();
+    }
+}
+
+bool FileLoader::next(LoadedFile &file)
+{
+    unique_lock<mutex> guard(lock);
+    if (handedOut == pending.size()) {
+        return false;
+    }
+    size_t position = handedOut++;
+    fileTaken.notify_all();
+    fileLoaded.wait(guard, [this, position] { return loaded.count(position) != 0; });
+    auto found = loaded.find(position);
+    file = std::move(found->second);
+    loaded.erase(found);
+    return true;
+}
+
+size_t FileLoader::size() const
+{
+    return pending.size();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file FileLoader.h
+ * @brief Contains the FileLoader class definition, which finds input files and reads them ahead of the parsers.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_FILELOADER_H_H
+#define PROJECT1_FILELOADER_H_H
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief An input file together with its contents.
+ */
+struct LoadedFile
+{
+    /// The path of the file
+    std::experimental::filesystem::path path;
+    /// The path relative to the directory that was searched
+    std::experimental::filesystem::path relative;
+    /// The contents of the file, left empty when it is over the loader's size limit
+    std::string contents;
+    /// The size of the file in bytes
+    unsigned long long bytes;
+    /// Why the file could not be read, empty on success
+    std::string error;
+};
+
+/**
+ * @brief Finds input files under a directory and reads them on a pool of threads so parsers never wait on the disk.
+ * @details Files are found recursively and kept when their name (or, for patterns containing a '/', their relative
+ * path) matches an include glob and no exclude glob. Reader threads then take the files in sorted order and load
+ * them, and next hands them out in that same order however the reads finish. A reader waits before keeping a file
+ * that is more than the prefetch count ahead of the last one handed out, which bounds how many files are held in
+ * memory at once.
+ */
+class FileLoader
+{
+private:
+    /// The files to be read
+    std::vector<LoadedFile> pending;
+    /// Index of the next file in pending to read
+    std::atomic<size_t> nextPending;
+    /// Files which have been read and not yet handed out, by their index in pending
+    std::map<size_t, LoadedFile> loaded;
+    /// How far ahead of the next file to hand out a file may be read
+    size_t capacity;
+    /// Files larger than this many bytes are not read, 0 for no limit
+    unsigned int maxBytes;
+    /// Number of files handed out by next, which is also the index of the next one
+    size_t handedOut;
+    /// Guards loaded and handedOut
+    std::mutex lock;
+    /// Signalled when a file is added to loaded
+    std::condition_variable fileLoaded;
+    /// Signalled when next moves on to another file
+    std::condition_variable fileTaken;
+    /// Set when the loader is destroyed before every file was read
+    bool stopping;
+    /// The reader threads
+    std::vector<std::thread> readers;
+
+    /**
+     * Body of each reader thread.
+     */
+    void read();
+
+public:
+
+    /**
+     * FileLoader Constructor, finds the files and starts reading.
+     * @param directory the directory to search recursively
+     * @param includes globs of files to keep, every file is kept when empty
+     * @param excludes globs of files to skip
+     * @param readerCount the number of reader threads
+     * @param prefetch the most files to hold in memory before a parser takes them
+     * @param maxBytes files larger than this are handed out with their size but not read, 0 reads every file
+     * @return A FileLoader object
+     * @throw runtime_error if the directory cannot be searched
+     */
+    FileLoader(std::experimental::filesystem::path directory, const std::vector<std::string> &includes,
+               const std::vector<std::string> &excludes, unsigned int readerCount, unsigned int prefetch,
+               unsigned int maxBytes = 0) throw(std::runtime_error);
+
+    /**
+     * FileLoader Constructor for files that have already been found, starts reading.
+     * @param files the files to read, in the order they are wanted; only path and relative are used
+     * @param readerCount the number of reader threads
+     * @param prefetch the most files to hold in memory before a parser takes them
+     * @param maxBytes files larger than this are handed out with their size but not read, 0 reads every file
+     * @return A FileLoader object
+     */
+    FileLoader(std::vector<LoadedFile> files, unsigned int readerCount, unsigned int prefetch,
+               unsigned int maxBytes = 0);
+
+    /**
+     * FileLoader Destructor, stops and joins the reader threads.
+     */
+    ~FileLoader();
+
+    /**
+     * Waits for the next loaded file. May be called from several threads at once; files are handed out in order.
+     * @param file receives the file
+     * @return true if a file was returned, false once every file has been handed out
+     */
+    bool next(LoadedFile &file);
+
+    /**
+     * Checks whether a file matches the include and exclude globs.
+     * @param relative the path of the file relative to the searched directory
+     * @param includes globs of files to keep, every file is kept when empty
+     * @param excludes globs of files to skip
+     * @return true if the file is included and not excluded
+     */
+    static bool selects(const std::experimental::filesystem::path &relative, const std::vector<std::string> &includes,
+                        const std::vector<std::string> &excludes);
+
+    /**
+     * Finds the files below a directory without reading them.
+     * @param directory the directory to search recursively
+     * @param includes globs of files to keep, every file is kept when empty
+     * @param excludes globs of files to skip
+     * @return the files, sorted by relative path, with empty contents
+     * @throw runtime_error if the directory cannot be searched
+     */
+    static std::vector<LoadedFile> find(std::experimental::filesystem::path directory,
+                                        const std::vector<std::string> &includes,
+                                        const std::vector<std::string> &excludes) throw(std::runtime_error);
+
+    /**
+     * Gets the number of files that were found.
+     * @return the count
+     */
+    size_t size() const;
+};
+
+#endif
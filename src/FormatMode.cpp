@@ -0,0 +1,99 @@
+/**
+ * @file FormatMode.cpp
+ * @brief Contains the source code for the --format and --check modes of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FileLoader.h"
+#include "FormatMode.h"
+#include "Formatter.h"
+
+using namespace std;
+
+/**
+ * Formats one file, rewriting it in place unless only checking, and reports what happened.
+ * @param file the file and its contents
+ * @param checkOnly true to leave the file untouched
+ * @param limits the limits on the file
+ * @param consoleLock guards the console
+ * @return 0 if the file was already canonical, 1 if it was or would be rewritten, 2 if it cannot be formatted
+ */
+static int run_formatter(LoadedFile &file, bool checkOnly, const ParseLimits &limits, mutex &consoleLock) {
+    string error(file.error);
+    bool changed = false;
+    if (error.empty()) {
+        Formatter formatter(file.path, std::move(file.contents), limits, file.bytes);
+        if (!formatter.format()) {
+            error = formatter.getError();
+        }
+        else if (formatter.isChanged()) {
+            changed = true;
+            if (!checkOnly) {
+                ofstream out(file.path, ios::binary);
+                out.write(formatter.getFormatted().data(), static_cast<streamsize>(formatter.getFormatted().size()));
+                if (!out) {
+                    error = "cannot write file";
+                }
+            }
+        }
+    }
+    lock_guard<mutex> guard(consoleLock);
+    if (!error.empty()) {
+        cout << "Cannot format " << file.path.string() << ": " << error << endl;
+        return 2;
+    }
+    if (changed) {
+        cout << (checkOnly ? "Not formatted: " : "Formatted: ") << file.path.string() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int run_format(const string &fileName, const DirectoryOptions &directory, const ParseLimits &limits,
+               bool checkOnly) throw(runtime_error) {
+    atomic<unsigned int> counts[3];
+    for (atomic<unsigned int> &count : counts) {
+        count = 0;
+    }
+    mutex consoleLock;
+    if (!fileName.empty()) {
+        LoadedFile file;
+        file.path = fileName;
+        file.bytes = 0;
+        {
+            FileLoader loader(vector<LoadedFile>(1, file), 1, 1, limits.maxBytes);
+            loader.next(file);
+        }
+        counts[run_formatter(file, checkOnly, limits, consoleLock)]++;
+    }
+    else {
+        FileLoader loader(directory.directory, directory.includes, directory.excludes, directory.readers,
+                          directory.prefetch, limits.maxBytes);
+        auto work = [&]() {
+            LoadedFile file;
+            while (loader.next(file)) {
+                counts[run_formatter(file, checkOnly, limits, consoleLock)]++;
+            }
+        };
+        vector<thread> workers;
+        for (unsigned int i = 1; i < directory.jobs; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (thread &worker : workers) {
+            worker.join();
+        }
+    }
+    unsigned int total = counts[0] + counts[1] + counts[2];
+    cout << total << " files, " << counts[1] << (checkOnly ? " not formatted, " : " formatted, ") << counts[2]
+        << " could not be formatted" << endl;
+    return counts[2] > 0 || (checkOnly && counts[1] > 0) ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file FormatMode.h
+ * @brief Contains the --format and --check modes of the driver, which rewrite files in the canonical layout.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_FORMATMODE_H_H
+#define PROJECT1_FORMATMODE_H_H
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "Lexer.h"
+#include "ParseRun.h"
+
+/**
+ * Formats a single file, or every selected file below a directory on a pool of threads, printing a line for each file
+ * that is or would be rewritten or cannot be formatted and then a summary.
+ * @param fileName the file to format, empty to format the files of the directory
+ * @param directory the files to format when fileName is empty, and how to read them
+ * @param limits the limits on each file
+ * @param checkOnly true to leave the files untouched and only report them
+ * @return the exit code: 1 if a file cannot be formatted or, when only checking, is not in the canonical layout
+ * @throw runtime_error if the directory cannot be searched
+ */
+int run_format(const std::string &fileName, const DirectoryOptions &directory, const ParseLimits &limits,
+               bool checkOnly) throw(std::runtime_error);
+
+#endif //PROJECT1_FORMATMODE_H_H
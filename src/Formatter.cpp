@@ -0,0 +1,143 @@
+/**
+ * @file Formatter.cpp
+ * @brief Contains the source code for the Formatter class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "Formatter.h"
+
+using namespace std;
+
+/// The indentation added for each level of nesting
+static const unsigned int indentWidth = 2;
+
+Formatter::Formatter(std::experimental::filesystem::path filename, std::string contents,
+                     const ParseLimits &limitsval, unsigned long long bytesval) :
+    limits(limitsval),
+    bytes(std::max<unsigned long long>(bytesval, contents.length())),
+    lexer(filename, std::move(contents))
+{
+}
+
+bool Formatter::fail(const std::string &message, unsigned int offset) {
+    SourceLocation location = lexer.locate(offset);
+    error = message + " at " + to_string(location.line) + ":" + to_string(location.column);
+    return false;
+}
+
+void Formatter::append(const LexedToken &token, Token previous, bool atLineStart) {
+    if (atLineStart) {
+        formatted.append(indentation);
+    }
+    else {
+        bool tight = token.token == CLOSEPAREN || token.token == COMMA || token.token == SEMICOLON
+            || token.token == COLON || token.token == PERIOD || previous == OPENPAREN
+            || (token.token == OPENPAREN && previous != STRING);
+        if (!tight) {
+            formatted.push_back(' ');
+        }
+    }
+    if (token.token == STRING) {
+        formatted.push_back('"');
+        formatted.append(token.lexeme);
+        formatted.push_back('"');
+    }
+    else {
+        formatted.append(token.lexeme);
+    }
+}
+
+bool Formatter::format() {
+    const string &source = lexer.getSource();
+    formatted.clear();
+    indentation.clear();
+    error.clear();
+    if (limits.maxBytes && bytes > limits.maxBytes) {
+        error = "file is " + to_string(bytes) + " bytes, more than the limit of " + to_string(limits.maxBytes);
+        return false;
+    }
+    // canonical files are usually about as long as the original, so this is normally the only allocation
+    formatted.reserve(source.length() + source.length() / 8 + 16);
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(limits.maxMilliseconds);
+
+    LexedToken token(lexer.getStartToken());
+    Token previous = NONE;
+    unsigned int previousOffset = 0;
+    unsigned int depth = 0;
+    unsigned int tokens = 0;
+    bool atLineStart = true;
+    unsigned int skipped = 0;
+    while (true) {
+        skipped = token.end;
+        if (!lexer.scanNext(token)) {
+            break;
+        }
+        if (!token.settled || token.token == NONE) {
+            return fail("invalid lexeme \"" + token.lexeme + "\"", token.offset);
+        }
+        // a quoted lexeme cut short by punctuation is dropped by the lexer, so formatting would lose its text
+        for (unsigned int i = skipped; i < token.offset; ++i) {
+            char c = source[i];
+            if (c != ' ' && c != '\n' && c != '\r') {
+                return fail("unterminated text", i);
+            }
+        }
+        ++tokens;
+        if (limits.maxTokens && tokens > limits.maxTokens) {
+            return fail("more than the limit of " + to_string(limits.maxTokens) + " lexemes", token.offset);
+        }
+        if (limits.maxString && token.lexeme.length() > limits.maxString) {
+            return fail("lexeme longer than the limit of " + to_string(limits.maxString) + " bytes", token.offset);
+        }
+        if (limits.maxMilliseconds && (tokens & 63) == 0 && chrono::steady_clock::now() > deadline) {
+            return fail("took longer than the limit of " + to_string(limits.maxMilliseconds) + " ms",
+                        token.offset);
+        }
+
+        if (token.token == END && depth > 0) {
+            --depth;
+            indentation.resize(depth * indentWidth);
+        }
+        append(token, previous, atLineStart);
+        atLineStart = token.token == COLON || token.token == SEMICOLON || token.token == PERIOD
+            || token.token == GROUP;
+        if (atLineStart) {
+            formatted.push_back('\n');
+        }
+        if (token.token == COLON || token.token == GROUP) {
+            // every level costs its indentation on each line inside it, so a runaway nesting is stopped here
+            if (limits.maxDepth && depth >= limits.maxDepth) {
+                return fail("nesting is deeper than the limit of " + to_string(limits.maxDepth), token.offset);
+            }
+            ++depth;
+            indentation.append(indentWidth, ' ');
+        }
+        previous = token.token;
+        previousOffset = token.offset;
+    }
+    // the lexer only finishes a number at the character after it, so one left before the final line break would
+    // not lex the same way when the formatted file is read back
+    if (previous == NUMBER) {
+        return fail("bare number at the end of the file", previousOffset);
+    }
+    if (!atLineStart) {
+        formatted.push_back('\n');
+    }
+    return true;
+}
+
+const std::string &Formatter::getFormatted() const {
+    return formatted;
+}
+
+bool Formatter::isChanged() const {
+    return formatted != lexer.getSource();
+}
+
+const std::string &Formatter::getError() const {
+    return error;
+}
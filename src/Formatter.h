@@ -0,0 +1,101 @@
+/**
+ * @file Formatter.h
+ * @brief Contains the Formatter class definition, which rewrites a file in the canonical layout.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_FORMATTER_H_H
+#define PROJECT1_FORMATTER_H_H
+
+#pragma once
+
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <string>
+
+#include "Lexer.h"
+
+/**
+ * @brief Rewrites a file in one canonical layout, straight from its token stream.
+ * @details The canonical layout puts each widget, End and layout header on its own line, indented by two spaces for
+ * every Window, Panel and Group it is inside. Tokens are separated by a single space, except that there is none
+ * before ( ) , ; : and . or after (, and a space follows each comma; the ( after a Window title keeps its space.
+ * Formatting never changes the tokens of a file. Files containing invalid lexemes, or text the lexer would silently
+ * skip, are left alone, as are files ending in a bare number, which the final line break would leave unfinished.
+ * Formatting a formatted file changes nothing. The same limits as a parse apply, so a file too large or too deeply
+ * nested to parse is not formatted either.
+ */
+class Formatter
+{
+private:
+    /// The limits on the file
+    ParseLimits limits;
+    /// The size of the file in bytes, set before lexer takes the contents
+    unsigned long long bytes;
+    /// The lexer reading the file
+    Lexer lexer;
+    /// The formatted text
+    std::string formatted;
+    /// Why the file could not be formatted, empty on success
+    std::string error;
+    /// The spaces starting a line at the current depth, grown and shrunk a level at a time
+    std::string indentation;
+
+    /**
+     * Appends the canonical text of a lexeme.
+     * @param token the lexeme
+     * @param previous the token of the lexeme before it, NONE at the start of the file
+     * @param atLineStart true when the lexeme starts a new line
+     */
+    void append(const LexedToken &token, Token previous, bool atLineStart);
+
+    /**
+     * Stops formatting with an error at a place in the file.
+     * @param message what is wrong
+     * @param offset where in the file
+     * @return false
+     */
+    bool fail(const std::string &message, unsigned int offset);
+
+public:
+
+    /**
+     * Formatter Constructor
+     * @param filename the path of the file, used in diagnostics
+     * @param contents the text of the file
+     * @param limits the limits on the file; the time limit starts when format is called
+     * @param bytes the size of the file when it was too large to read and contents is empty, otherwise 0
+     * @return A Formatter object
+     */
+    Formatter(std::experimental::filesystem::path filename, std::string contents,
+              const ParseLimits &limits = ParseLimits::defaults(), unsigned long long bytes = 0);
+
+    /**
+     * Formats the file.
+     * @return true if the file could be formatted
+     */
+    bool format();
+
+    /**
+     * Gets the formatted text.
+     * @return the text, only meaningful when format returned true
+     */
+    const std::string &getFormatted() const;
+
+    /**
+     * Checks whether formatting changed the file.
+     * @return true if the formatted text differs from the original
+     */
+    bool isChanged() const;
+
+    /**
+     * Gets why the file could not be formatted.
+     * @return the reason, including its file:line:col
+     */
+    const std::string &getError() const;
+};
+
+#endif
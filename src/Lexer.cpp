@@ -6,122 +6,317 @@
  * @bug No known bugs at this time
  */
 
+#include <climits>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <fstream>
+#include <system_error>
+#include <thread>
 
+#include "AllocationTracker.h"
 #include "Lexer.h"
-#include "stringhelper.h"
+#include "Utf8.h"
 
 
 using namespace std;
 
-/**
- * Utility function used to check if a string is a valid number
- * @param number the string that may be a number
- * @return true if a number, false otherwise
- */
-bool checkNumber(string number) {
-    long val;
-    string check;
-    try {
-        val = std::stoi(number);
-        check = std::to_string(val);
-        if (check != number) {
-            return false;
-        }
+Lexer::Lexer(std::experimental::filesystem::path filename, unsigned int maxBytes) throw(runtime_error) :
+    fileReader(filename, ios::binary),
+    fileName(filename.string()),
+    punctuation("():;.,"),
+    fileString(""),
+    fileBytes(0),
+    producerDone(false),
+    stopProducer(false)
+{
+    AllocationScope scope(LEX_PHASE);
+    initialize();
+    if (!fileReader.is_open()) {
+        throw runtime_error("Invalid path to input file");
     }
 
-    catch (invalid_argument& e) {
-        return false;
+    // an oversized file is only measured, so the size limit protects memory as well as time
+    error_code sizeError;
+    uintmax_t size = std::experimental::filesystem::file_size(filename, sizeError);
+    if (maxBytes && !sizeError && size > maxBytes) {
+        fileBytes = size;
+        fileReader.close();
+        validateEncoding();
+        return;
     }
-    catch (out_of_range& e) {
-        return false;
-    }
-    return true;
+
+    // Line breaks are kept so that offsets refer to the original file; scan skips them.
+    fileString.assign(istreambuf_iterator<char>(fileReader), istreambuf_iterator<char>());
+    fileReader.close();
+    fileBytes = fileString.length();
+    validateEncoding();
+}
+
+Lexer::Lexer(std::experimental::filesystem::path filename, std::string contents, unsigned long long bytes) :
+    fileName(filename.string()),
+    punctuation("():;.,"),
+    fileString(std::move(contents)),
+    producerDone(false),
+    stopProducer(false)
+{
+    initialize();
+    fileBytes = std::max<unsigned long long>(bytes, fileString.length());
+    validateEncoding();
 }
 
-Lexer::Lexer(std::experimental::filesystem::path filename) throw(runtime_error) :
-    fileReader(filename),
-    currentLexeme(""),
-    lastLexeme(""),
+Lexer::Lexer(std::vector<LexedToken> tokens) :
     punctuation("():;.,"),
-    fileString("")
+    producerDone(false),
+    stopProducer(false)
 {
-    currentToken = NONE;
-    previousToken = NONE;
+    initialize();
+    fileBytes = 0;
+    validateEncoding();
+    lexedTokens = std::move(tokens);
+    lexedAhead = true;
+}
+
+void Lexer::initialize()
+{
+    current = getStartToken();
+    last = current;
     index = 0;
-    if (!fileReader.is_open()) {
-        throw runtime_error("Invalid path to input file");
-    }
-    string line("");
+    lexedPosition = 0;
+    lexedAhead = false;
+    limits = ParseLimits();
+    limited = false;
+    tokenCount = 0;
+    limitReached = false;
+}
+
+void Lexer::validateEncoding()
+{
+    invalidUtf8 = static_cast<unsigned int>(Utf8::validate(fileString.data(), fileString.length(), asciiOnly));
+}
+
+void Lexer::invalidByte(LexedToken &token) const
+{
+    static const char digits[] = "0123456789ABCDEF";
+    unsigned char byte = static_cast<unsigned char>(fileString[invalidUtf8]);
+    token.token = NONE;
+    token.settled = true;
+    token.offset = invalidUtf8;
+    token.end = invalidUtf8;
+    // the byte itself is not written out, so diagnostics and output files stay valid UTF-8
+    token.lexeme = "\\x";
+    token.lexeme.push_back(digits[byte >> 4]);
+    token.lexeme.push_back(digits[byte & 0xF]);
+    token.diagnostic = "Invalid UTF-8 byte 0x" + token.lexeme.substr(2);
+}
 
-    while (!fileReader.bad() && !fileReader.eof()) {
-        getline(fileReader, line);
-        if (line == "") continue;
-        fileString.append(line);
+Lexer::~Lexer()
+{
+    if (producer.joinable()) {
+        stopProducer.store(true);
+        producer.join();
     }
-    fileReader.close();
 }
 
 Token Lexer::getNextToken()
 {
-    lastLexeme = currentLexeme;
-    currentLexeme = getNextLexeme();
-    previousToken = currentToken;
-    return currentToken;
+    AllocationScope scope(LEX_PHASE);
+    last = current;
+    if (limited && limits.maxBytes && fileBytes > limits.maxBytes) {
+        return reportLimit("File is " + to_string(fileBytes) + " bytes, more than the limit of "
+                           + to_string(limits.maxBytes));
+    }
+    if (ring && lexedPosition == lexedTokens.size()) {
+        refill();
+    }
+    if (lexedAhead && lexedPosition < lexedTokens.size()) {
+        current = lexedTokens[lexedPosition++];
+    }
+    else {
+        scan(index, current);
+    }
+    index = current.end;
+    if (limited) {
+        ++tokenCount;
+        if (limits.maxTokens && tokenCount > limits.maxTokens) {
+            return reportLimit("More than the limit of " + to_string(limits.maxTokens) + " lexemes");
+        }
+        if (limits.maxString && current.lexeme.length() > limits.maxString) {
+            return reportLimit("Lexeme of " + to_string(current.lexeme.length()) + " bytes is longer than the limit of "
+                               + to_string(limits.maxString));
+        }
+        // reading the clock costs more than lexing a short lexeme, so only look every 64
+        if (limits.maxMilliseconds && (tokenCount & 63) == 0 && chrono::steady_clock::now() > deadline) {
+            return reportLimit("Took longer than the limit of " + to_string(limits.maxMilliseconds) + " ms");
+        }
+    }
+    return current.token;
+}
+
+const std::string &Lexer::getCurrentLexeme() const {
+    return current.lexeme;
+}
+
+const std::string &Lexer::getPreviousLexeme() const {
+    return last.lexeme;
+}
+
+int Lexer::getPreviousNumber() {
+    return last.number;
+}
+
+std::string Lexer::getDiagnostic() {
+    return current.diagnostic;
+}
+
+unsigned int Lexer::getCurrentOffset() {
+    return current.offset;
+}
+
+unsigned int Lexer::getPreviousOffset() {
+    return last.offset;
+}
+
+SourceLocation Lexer::locate(unsigned int offset)
+{
+    if (lineStarts.empty()) {
+        // Built on the first diagnostic only; count first so the table is allocated once, then let memchr find
+        // each line break.
+        const char *begin = fileString.data();
+        const char *end = begin + fileString.length();
+        lineStarts.reserve(std::count(begin, end, '\n') + 1);
+        lineStarts.push_back(0);
+        for (const char *p = begin; (p = static_cast<const char *>(memchr(p, '\n', end - p))) != nullptr; ++p) {
+            lineStarts.push_back(static_cast<unsigned int>(p - begin) + 1);
+        }
+    }
+    auto line = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - 1;
+    SourceLocation location;
+    location.line = static_cast<unsigned int>(line - lineStarts.begin()) + 1;
+    location.column = static_cast<unsigned int>(asciiOnly ? offset - *line
+        : Utf8::countCharacters(fileString.data() + *line, fileString.data() + offset)) + 1;
+    return location;
 }
 
-std::string Lexer::getCurrentLexeme() {
-    return currentLexeme;
+std::string Lexer::getCurrentLocation()
+{
+    SourceLocation location = locate(current.offset);
+    return fileName + ":" + std::to_string(location.line) + ":" + std::to_string(location.column);
 }
 
-std::string Lexer::getNextLexeme()
+void Lexer::scanQuoted(unsigned int start, LexedToken &token) const
 {
-    string possibleLexeme("");
+    // Inside quotes, punctuation still ends the lexeme and line breaks are dropped; everything else is copied.
+    // None of the stop characters can appear inside a multibyte character, so those are copied whole.
+    size_t stop = fileString.find_first_of("\"():;.,", start);
+    size_t last = stop == string::npos ? fileString.length() : stop;
+    if (invalidUtf8 >= start && invalidUtf8 < last) {
+        invalidByte(token);
+        return;
+    }
+    token.lexeme.reserve(last - start);
+    for (size_t i = start; i < last; ++i) {
+        if (fileString[i] != '\n' && fileString[i] != '\r') {
+            token.lexeme.push_back(fileString[i]);
+        }
+    }
+    token.end = static_cast<unsigned int>(last);
+    if (stop == string::npos) {
+        return;
+    }
+    token.end++;
+    token.settled = true;
+    if (fileString[stop] == '"') {
+        token.token = STRING;
+        return;
+    }
+    token.offset = static_cast<unsigned int>(stop);
+    token.lexeme.assign(1, fileString[stop]);
+    token.token = checkLexeme(token.lexeme);
+}
+
+void Lexer::scan(unsigned int start, LexedToken &token) const
+{
+    string &possibleLexeme = token.lexeme;
     char c;
     bool checkquotes = false;
     bool checknumber = false;
+    bool overflow = false;
+    long long number = 0;
+    bool started = false;
+    unsigned int index = start;
+    possibleLexeme.clear();
+    token.diagnostic.clear();
+    token.settled = false;
+    token.offset = static_cast<unsigned int>(fileString.length());
 
     // this is all a little convoluted but it works.
-    for(index; index < fileString.length(); ++index){
+    for(; index < fileString.length(); ++index){
         c = fileString[index];
         // check newline characters for linux mainly.
         if (c == '\n' || c == '\r' || (c == ' ' && !checkquotes && !checknumber)) continue;
+        if (!started) {
+            token.offset = index;
+            started = true;
+        }
         
+        if (c == '"' && possibleLexeme.empty() && !checknumber) {
+            scanQuoted(index + 1, token);
+            return;
+        }
         if (c == '"') {
             checkquotes = !checkquotes;
             if (!checkquotes) {
                 index++;
-                currentToken = STRING;
+                token.token = STRING;
+                token.settled = true;
                 break;
             }
             else {
                 continue;
             }
         }
-        else if (isdigit(c) && !checkquotes) {
-            possibleLexeme.append(StringHelper::toString(c));
+        else if (isdigit(static_cast<unsigned char>(c)) && !checkquotes) {
+            possibleLexeme.push_back(c);
             checknumber = true;
+            if (!overflow) {
+                number = number * 10 + (c - '0');
+                overflow = number > INT_MAX;
+            }
             continue;
         }
         else if (checknumber) {
             checknumber = !checknumber;
-            currentToken = NUMBER;
+            token.settled = true;
+            if (overflow) {
+                token.token = NONE;
+                token.diagnostic = "Number " + possibleLexeme + " is larger than " + std::to_string(INT_MAX);
+            }
+            else {
+                token.token = NUMBER;
+                token.number = static_cast<int>(number);
+            }
             break;
         }
 
+        if (index == invalidUtf8) {
+            invalidByte(token);
+            return;
+        }
         if (std::find(punctuation.begin(), punctuation.end(), c) != punctuation.end()) {
 
             index++;
 
-            currentToken = checkLexeme(StringHelper::toString(c));
-            possibleLexeme = StringHelper::toString(c);
+            possibleLexeme.assign(1, c);
+            token.token = checkLexeme(possibleLexeme);
+            token.settled = true;
             break;
         }
-        else if (isalpha(c) || checkquotes) {
-            possibleLexeme.append(StringHelper::toString(c));
+        else if (isalpha(static_cast<unsigned char>(c)) || checkquotes) {
+            possibleLexeme.push_back(c);
             if (checkquotes) continue;
-            if ((currentToken = checkLexeme(possibleLexeme)) != NONE) {
+            token.settled = true;
+            if ((token.token = checkLexeme(possibleLexeme)) != NONE) {
                 index++;
                 break;
             }
@@ -130,110 +325,335 @@ std::string Lexer::getNextLexeme()
             }
         }
         else {
-            currentToken = NONE;
-            if (!possibleLexeme.empty()) {
-                return possibleLexeme.append(StringHelper::toString(c));
-            }
-            else
-            {
-                return StringHelper::toString(c);
-            }
+            token.token = NONE;
+            token.settled = true;
+            // keep a multibyte character whole so the diagnostic shows it
+            unsigned int length = Utf8::sequenceLength(fileString.data() + index, fileString.length() - index);
+            possibleLexeme.append(fileString, index, std::max(1u, length));
+            break;
         }
     }
-    return possibleLexeme;
+    token.end = index;
 }
 
-Token Lexer::checkLexeme(string lexeme)
+bool Lexer::scanRange(unsigned int start, unsigned int stop, LexedToken seed, std::vector<LexedToken> &tokens) const
 {
-    Token nexttoken = NONE;
-    if (lexeme == "(")
-    {
-        nexttoken = OPENPAREN;
-    }
-    else if (lexeme == ")")
-    {
-        nexttoken = CLOSEPAREN;
-    }
-    else if (lexeme == "Window")
-    {
-        nexttoken = WINDOW;
-    }
-    else if (lexeme == "Layout")
-    {
-        nexttoken = LAYOUT;
-    }
-    else if (lexeme == "Flow")
-    {
-        nexttoken = FLOW;
-    }
-    else if (lexeme == "Border")
-    {
-        nexttoken = BORDER;
+    unsigned int position = start;
+    while (position < stop) {
+        scan(position, seed);
+        tokens.push_back(seed);
+        if (seed.end == position) {
+            return true;
+        }
+        position = seed.end;
+        // the caller throws the lexemes away once the time is up, so stop making them
+        if ((tokens.size() & 1023) == 0 && isPastDeadline()) {
+            return false;
+        }
     }
-    else if (lexeme == "Grid")
-    {
-        nexttoken = GRID;
+    return false;
+}
+
+void Lexer::lexAhead(unsigned int threads, unsigned int minimumChunk)
+{
+    if (limited && limits.maxBytes && fileBytes > limits.maxBytes) {
+        return;
     }
-    else if (lexeme == "LEFT")
-    {
-        nexttoken = LEFT;
+    AllocationLedger *ledger = AllocationScope::currentLedger();
+    AllocationScope scope(LEX_PHASE);
+    unsigned int length = static_cast<unsigned int>(fileString.length());
+    unsigned int chunks = std::max(1u, std::min(threads, length / std::max(1u, minimumChunk)));
+    vector<unsigned int> splits(chunks + 1);
+    for (unsigned int j = 0; j <= chunks; ++j) {
+        splits[j] = static_cast<unsigned int>(static_cast<unsigned long long>(length) * j / chunks);
     }
-    else if (lexeme == "RIGHT")
+    splits[0] = index;
+
+    // guesses[2j] assumes chunk j starts on a lexeme, guesses[2j + 1] assumes it starts inside a quoted lexeme
+    struct Guess
     {
-        nexttoken = RIGHT;
+        unsigned int start;
+        bool stuck;
+        vector<LexedToken> tokens;
+    };
+    vector<Guess> guesses(2 * chunks);
+    auto lexChunk = [&](unsigned int j) {
+        AllocationScope chunkScope(ledger, LEX_PHASE);
+        Guess &boundary = guesses[2 * j];
+        boundary.start = splits[j];
+        boundary.stuck = scanRange(boundary.start, splits[j + 1], current, boundary.tokens);
+        if (j == 0) {
+            return;
+        }
+        Guess &quoted = guesses[2 * j + 1];
+        size_t close = fileString.find_first_of("\"():;.,", splits[j]);
+        quoted.start = close == string::npos ? length : static_cast<unsigned int>(close) + 1;
+        quoted.stuck = scanRange(quoted.start, splits[j + 1], current, quoted.tokens);
+    };
+    vector<thread> workers;
+    for (unsigned int j = 1; j < chunks; ++j) {
+        workers.emplace_back(lexChunk, j);
     }
-    else if (lexeme == "CENTER")
-    {
-        nexttoken = CENTER;
+    lexChunk(0);
+    for (thread &worker : workers) {
+        worker.join();
     }
-    else if (lexeme == "Button")
-    {
-        nexttoken = BUTTON;
+    // a chunk may have stopped short when the time ran out; getNextToken lexes serially and reports it
+    if (isPastDeadline()) {
+        return;
     }
-    else if (lexeme == "Group")
-    {
-        nexttoken = GROUP;
+
+    // Stitch the chunks in order. A guess only knew its own previous lexeme, so carried token kinds and numbers are
+    // fixed up from the real one.
+    lexedTokens.clear();
+    LexedToken previous = current;
+    unsigned int position = index;
+    bool stuck = false;
+    auto append = [&](LexedToken token) {
+        if (!token.settled) {
+            token.token = previous.token;
+        }
+        if (!token.settled || token.token != NUMBER) {
+            token.number = previous.number;
+        }
+        lexedTokens.push_back(token);
+        previous = token;
+    };
+    for (unsigned int j = 0; j < chunks && !stuck; ++j) {
+        if (position >= splits[j + 1]) {
+            continue;
+        }
+        const Guess *match = nullptr;
+        size_t first = 0;
+        for (unsigned int g = 2 * j; g < 2 * j + 2 && match == nullptr; ++g) {
+            const Guess &guess = guesses[g];
+            if (guess.tokens.empty()) {
+                continue;
+            }
+            if (guess.start == position) {
+                match = &guess;
+                first = 0;
+                continue;
+            }
+            auto found = std::lower_bound(guess.tokens.begin(), guess.tokens.end(), position,
+                                          [](const LexedToken &token, unsigned int end) { return token.end < end; });
+            if (found != guess.tokens.end() && found->end == position && found + 1 != guess.tokens.end()) {
+                match = &guess;
+                first = static_cast<size_t>(found - guess.tokens.begin()) + 1;
+            }
+        }
+        if (match != nullptr) {
+            for (size_t t = first; t < match->tokens.size(); ++t) {
+                append(match->tokens[t]);
+            }
+            position = previous.end;
+            stuck = match->stuck;
+        }
+        else {
+            // neither guess lines up, so lex this chunk serially from where the previous one ended
+            vector<LexedToken> serial;
+            stuck = scanRange(position, splits[j + 1], previous, serial);
+            for (LexedToken &token : serial) {
+                append(token);
+            }
+            position = previous.end;
+        }
     }
-    else if (lexeme == "Label")
-    {
-        nexttoken = LABEL;
+    if (isPastDeadline()) {
+        lexedTokens.clear();
+        return;
     }
-    else if (lexeme == "Panel")
-    {
-        nexttoken = PANEL;
+    index = position;
+    lexedPosition = 0;
+    lexedAhead = true;
+}
+
+void Lexer::produce(unsigned int batchSize, unsigned int start, LexedToken token, AllocationLedger *ledger)
+{
+    AllocationScope scope(ledger, LEX_PHASE);
+    unsigned int position = start;
+    vector<LexedToken> batch;
+    batch.reserve(batchSize);
+    bool finished = false;
+    while (!finished) {
+        scan(position, token);
+        // stop once the file is used up or a lexeme does not consume anything, every later lexeme would repeat it
+        finished = token.end == position || token.end >= fileString.length();
+        position = token.end;
+        batch.push_back(token);
+        // once the time is up, hand over what there is; getNextToken lexes any rest serially and reports the limit
+        if ((batch.size() & 63) == 0 && isPastDeadline()) {
+            finished = true;
+        }
+        if (batch.size() == batchSize || finished) {
+            while (!ring->tryPush(batch)) {
+                if (stopProducer.load(memory_order_relaxed)) {
+                    return;
+                }
+                this_thread::yield();
+            }
+            batch.clear();
+            batch.reserve(batchSize);
+        }
     }
-    else if (lexeme == "Textfield")
-    {
-        nexttoken = TEXTFIELD;
+    producerDone.store(true, memory_order_release);
+}
+
+void Lexer::refill()
+{
+    while (!ring->tryPop(lexedTokens)) {
+        if (producerDone.load(memory_order_acquire)) {
+            // the producer may have pushed its last batch just before finishing
+            if (ring->tryPop(lexedTokens)) {
+                break;
+            }
+            producer.join();
+            ring.reset();
+            lexedTokens.clear();
+            lexedPosition = 0;
+            return;
+        }
+        this_thread::yield();
     }
-    else if (lexeme == "Radio")
-    {
-        nexttoken = RADIO;
+    lexedPosition = 0;
+}
+
+void Lexer::pipeline(unsigned int batchSize, unsigned int batches)
+{
+    if (limited && limits.maxBytes && fileBytes > limits.maxBytes) {
+        return;
     }
-    else if (lexeme == ";")
-    {
-        nexttoken = SEMICOLON;
+    ring.reset(new SpscRing<vector<LexedToken>>(batches));
+    lexedTokens.clear();
+    lexedPosition = 0;
+    lexedAhead = true;
+    producer = thread(&Lexer::produce, this, std::max(1u, batchSize), index, current,
+                      AllocationScope::currentLedger());
+}
+
+bool Lexer::scanNext(LexedToken &token) const
+{
+    unsigned int start = token.end;
+    if (start >= fileString.length()) {
+        return false;
     }
-    else if (lexeme == ":")
-    {
-        nexttoken = COLON;
+    scan(start, token);
+    return token.settled || !token.lexeme.empty();
+}
+
+LexedToken Lexer::getStartToken() const
+{
+    LexedToken token;
+    token.token = NONE;
+    token.number = 0;
+    token.offset = 0;
+    token.end = 0;
+    token.settled = true;
+    return token;
+}
+
+const std::string &Lexer::getSource() const
+{
+    return fileString;
+}
+
+size_t Lexer::getCurrentPosition() const
+{
+    return lexedPosition - 1;
+}
+
+Token Lexer::resumeAt(size_t position)
+{
+    current = lexedTokens[position - 1];
+    lexedPosition = position;
+    index = current.end;
+    tokenCount = static_cast<unsigned int>(position);
+    return getNextToken();
+}
+
+void Lexer::setLimits(const ParseLimits &fileLimits, std::chrono::steady_clock::time_point start)
+{
+    limits = fileLimits;
+    limited = limits.maxBytes || limits.maxTokens || limits.maxString || limits.maxMilliseconds;
+    limitStart = start;
+    deadline = start + chrono::milliseconds(limits.maxMilliseconds);
+}
+
+const ParseLimits &Lexer::getLimits() const
+{
+    return limits;
+}
+
+std::chrono::steady_clock::time_point Lexer::getLimitStart() const
+{
+    return limitStart;
+}
+
+Token Lexer::reportLimit(const std::string &diagnostic)
+{
+    const size_t shown = 64;
+    if (current.lexeme.length() > shown) {
+        size_t cut = shown;
+        // do not split a multibyte character
+        while (cut > 0 && (static_cast<unsigned char>(current.lexeme[cut]) & 0xC0) == 0x80) {
+            --cut;
+        }
+        current.lexeme.resize(cut);
+        current.lexeme.append("...");
     }
-    else if (lexeme == "Flow")
-    {
-        nexttoken = FLOW;
+    current.token = NONE;
+    current.settled = true;
+    current.diagnostic = diagnostic;
+    limitReached = true;
+    return NONE;
+}
+
+bool Lexer::isPastDeadline() const
+{
+    return limits.maxMilliseconds && chrono::steady_clock::now() > deadline;
+}
+
+bool Lexer::isLimitReached() const
+{
+    return limitReached;
+}
+
+const std::vector<LexedToken> &Lexer::getLexedTokens() const {
+    return lexedTokens;
+}
+
+Token Lexer::checkLexeme(const string &lexeme) const
+{
+    if (lexeme.length() == 1) {
+        switch (lexeme[0]) {
+            case '(': return OPENPAREN;
+            case ')': return CLOSEPAREN;
+            case ';': return SEMICOLON;
+            case ':': return COLON;
+            case ',': return COMMA;
+            case '.': return PERIOD;
+            default: break;
+        }
     }
-    else if (lexeme == ",")
+    // scan calls this after every letter of a word, so compare the length and first letter before the text
+    static const struct
     {
-        nexttoken = COMMA;
-    }
-    else if(lexeme == "."){
-        nexttoken = PERIOD;
-    }
-    else if(lexeme == "End"){
-        nexttoken = END;
-    }
-    else if (checkNumber(lexeme)) {
-        nexttoken = NUMBER;
+        const char *text;
+        size_t length;
+        Token token;
+    } keywords[] = {
+        { "Window", 6, WINDOW }, { "Layout", 6, LAYOUT }, { "Flow", 4, FLOW }, { "Border", 6, BORDER },
+        { "Grid", 4, GRID }, { "LEFT", 4, LEFT }, { "RIGHT", 5, RIGHT }, { "CENTER", 6, CENTER },
+        { "Button", 6, BUTTON }, { "Group", 5, GROUP }, { "Label", 5, LABEL }, { "Panel", 5, PANEL },
+        { "Textfield", 9, TEXTFIELD }, { "Radio", 5, RADIO }, { "End", 3, END }
+    };
+    if (!lexeme.empty() && isalpha(static_cast<unsigned char>(lexeme[0]))) {
+        for (const auto &keyword : keywords) {
+            if (keyword.length == lexeme.length() && keyword.text[0] == lexeme[0]
+                && lexeme.compare(keyword.text) == 0) {
+                return keyword.token;
+            }
+        }
     }
-    return nexttoken;
+    return NONE;
 }
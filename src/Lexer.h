@@ -10,16 +10,24 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #ifdef _WIN32
 #include <experimental\filesystem>
 #elif __linux__
 #include <experimental/filesystem>
 #endif
+#include <fstream>
 #include <functional>
 #include <list>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "AllocationTracker.h"
+#include "SpscRing.h"
+
 /**
  * This enumeration contains all Tokens used in the associated grammar.
  */
@@ -29,6 +37,67 @@ enum Token
     BUTTON,	GROUP, LABEL, PANEL, TEXTFIELD,	RADIO, END,	PERIOD,	NONE, ENDOFLINE, ENDOFFILE, NUMBER,	COMMA
 };
 
+/**
+ * @brief A line and column in an input file, both starting at 1.
+ */
+struct SourceLocation
+{
+    /// The line number
+    unsigned int line;
+    /// The character within the line, counting each UTF-8 character once
+    unsigned int column;
+};
+
+/**
+ * @brief Per-file limits which stop a file before it can stall a run. A limit of 0 is no limit.
+ */
+struct ParseLimits
+{
+    /// Largest file in bytes
+    unsigned int maxBytes;
+    /// Most lexemes handed to the parser
+    unsigned int maxTokens;
+    /// Deepest nesting of Window, Panel and Group, counting the Window as 1
+    unsigned int maxDepth;
+    /// Longest lexeme in bytes, which includes a quoted string running to the end of the file
+    unsigned int maxString;
+    /// Longest time spent lexing and parsing, in milliseconds
+    unsigned int maxMilliseconds;
+
+    /**
+     * Gets the limits that apply unless others are given: every limit is off except nesting, which is deep enough
+     * for any real file but stops a runaway one well before it can overflow the stack.
+     * @return the limits
+     */
+    static ParseLimits defaults()
+    {
+        ParseLimits limits = ParseLimits();
+        limits.maxDepth = 1000;
+        return limits;
+    }
+};
+
+/**
+ * @brief A lexeme together with its token and position.
+ */
+struct LexedToken
+{
+    /// The token that is related to the lexeme
+    Token token;
+    /// The text of the lexeme
+    std::string lexeme;
+    /// The value of the lexeme when it is a NUMBER
+    int number;
+    /// Byte offset in the file where the lexeme starts
+    unsigned int offset;
+    /// Byte offset in the file where lexing of the following lexeme starts
+    unsigned int end;
+    /// false when the file ended before the lexeme was classified; token and number then carry over
+    bool settled;
+    /// Explains why the lexeme is invalid, empty when there is nothing to report
+    std::string diagnostic;
+};
+
 /**
  * @brief This class is used to Lex a specific grammar:
  * @details This class is used to Lex a specific grammar:\n
@@ -54,55 +123,308 @@ class Lexer
 private:
     /// A file stream reading from the current file to be parsed.
     std::ifstream fileReader;
-    /// String which contains the lexeme currently being parsed/lexed
-    std::string currentLexeme;
-    /// The string containing the lexeme that was previously looked at
-    std::string lastLexeme;
+    /// The path of the file, used in diagnostics.
+    std::string fileName;
     /// A string containing punctuation values which are delimiters in some way.
     std::string punctuation;
     /// String containing the text of the file
     std::string fileString;
-    /// The token that is related to the current lexeme.
-    Token currentToken;
-    /// The token that is related to the prior lexeme.
-    Token previousToken;
+    /// The size of the file in bytes, more than fileString holds when the file was over the size limit and not read.
+    unsigned long long fileBytes;
+    /// The lexeme currently being looked at.
+    LexedToken current;
+    /// The lexeme that was looked at before the current one.
+    LexedToken last;
     /// Index into the file.
     unsigned int index;
+    /// Offset of the first byte of each line, built the first time a location is needed.
+    std::vector<unsigned int> lineStarts;
+    /// Offset of the first byte which is not valid UTF-8, the file length if there is none.
+    unsigned int invalidUtf8;
+    /// true if every byte of the file is ASCII, so columns are byte offsets.
+    bool asciiOnly;
+    /// Lexemes produced ahead of time by lexAhead.
+    std::vector<LexedToken> lexedTokens;
+    /// The next entry of lexedTokens to hand out.
+    size_t lexedPosition;
+    /// true once lexAhead has run and getNextToken reads from lexedTokens.
+    bool lexedAhead;
+    /// The limits on this file.
+    ParseLimits limits;
+    /// true if any of limits is set.
+    bool limited;
+    /// When the limits started to apply.
+    std::chrono::steady_clock::time_point limitStart;
+    /// limitStart plus the time limit.
+    std::chrono::steady_clock::time_point deadline;
+    /// The number of calls to getNextToken.
+    unsigned int tokenCount;
+    /// true once a limit has stopped the file.
+    bool limitReached;
+    /// Batches of lexemes passed from the producer thread in pipelined mode.
+    std::unique_ptr<SpscRing<std::vector<LexedToken>>> ring;
+    /// The thread lexing ahead of the parser in pipelined mode.
+    std::thread producer;
+    /// Set by the producer once it has pushed its last batch.
+    std::atomic<bool> producerDone;
+    /// Tells the producer to give up, e.g. because the parser stopped early.
+    std::atomic<bool> stopProducer;
 
     /**
-     * Validates that the retrieved lexeme is a valid token.
+     * Validates that the retrieved lexeme is a valid punctuation or keyword token. Numbers are decoded by scan.
      * @param lexeme a string to be compared against valid tokens
      * @return The corresponding token
      */
-    Token checkLexeme(std::string lexeme);
+    Token checkLexeme(const std::string &lexeme) const;
 
     /**
-	 * Retrieves the next lexeme from the file.
-	 * @return
-	 */
-    std::string getNextLexeme();
+     * Lexes one lexeme. This does not change the Lexer, so any number of threads may scan the same file at once.
+     * @param start the index into the file to start at
+     * @param token holds the previous lexeme on entry, whose token and number carry over if the file ends before the
+     * new lexeme is classified, and receives the new lexeme
+     */
+    void scan(unsigned int start, LexedToken &token) const;
+
+    /**
+     * Checks that the file is UTF-8 and records the first invalid byte. Called once the file text is in place.
+     */
+    void validateEncoding();
+
+    /**
+     * Makes a NONE lexeme reporting the first invalid UTF-8 byte. Like any NONE lexeme it does not advance.
+     * @param token receives the lexeme
+     */
+    void invalidByte(LexedToken &token) const;
+
+    /**
+     * Reads the rest of a STRING lexeme after its opening quote in one pass.
+     * @param start the index just after the opening quote
+     * @param token receives the lexeme
+     */
+    void scanQuoted(unsigned int start, LexedToken &token) const;
+
+    /**
+     * Lexes consecutive lexemes until one ends at or after stop.
+     * @param start the index into the file to start at
+     * @param stop the index at which to stop
+     * @param seed the lexeme assumed to precede start
+     * @param tokens receives the lexemes
+     * @return true if lexing got stuck on a lexeme that does not consume any input
+     */
+    bool scanRange(unsigned int start, unsigned int stop, LexedToken seed, std::vector<LexedToken> &tokens) const;
+
+    /**
+     * Sets up the lexer state shared by the constructors.
+     */
+    void initialize();
+
+    /**
+     * Body of the producer thread in pipelined mode: lexes the file in batches and pushes them into the ring.
+     * @param batchSize the number of lexemes per batch
+     * @param start the index into the file to start at
+     * @param token the lexeme preceding start
+     * @param ledger the ledger charged for allocations made while lexing, may be null
+     */
+    void produce(unsigned int batchSize, unsigned int start, LexedToken token, AllocationLedger *ledger);
+
+    /**
+     * Waits for the next batch from the producer thread. Leaves pipelined mode once the producer is finished and
+     * every batch has been handed out.
+     */
+    void refill();
 
 public:
+    /// The fewest bytes lexAhead gives a thread unless told otherwise
+    static const unsigned int defaultChunk = 1u << 16;
 
 	/**
 	 * Lexer Constructor
 	 * @param filename the path to an input file to be lexed
+	 * @param maxBytes a file larger than this is not read, only reported by getNextToken once setLimits applies the
+	 * same limit; 0 reads any file
 	 * @return A Lexer object
 	 * @throw runtime_error
 	 */
-	Lexer(std::experimental::filesystem::path filename) throw(std::runtime_error);
+	Lexer(std::experimental::filesystem::path filename, unsigned int maxBytes = 0) throw(std::runtime_error);
+
+	/**
+	 * Lexer Constructor for a file that has already been read
+	 * @param filename the path of the file, used in diagnostics
+	 * @param contents the text of the file
+	 * @param bytes the size of the file when it was too large to read and contents is empty, otherwise 0
+	 * @return A Lexer object
+	 */
+	Lexer(std::experimental::filesystem::path filename, std::string contents, unsigned long long bytes = 0);
+
+	/**
+	 * Lexer Constructor which replays lexemes lexed elsewhere instead of reading a file, e.g. for parsing part of a
+	 * file on another thread. Once the lexemes run out it behaves as if the file had ended.
+	 * @param tokens the lexemes to hand out, in order
+	 * @return A Lexer object
+	 */
+	explicit Lexer(std::vector<LexedToken> tokens);
+
+	/**
+	 * Lexer Destructor, stops the producer thread if one is running.
+	 */
+	~Lexer();
 
 	/**
 	 * Gets the lexeme that is currently being looked at.
-	 * @return the lexeme
+	 * @return the lexeme, valid until the next call to getNextToken
+	 */
+    const std::string &getCurrentLexeme() const;
+
+	/**
+	 * Gets the lexeme that was looked at before the current one.
+	 * @return the lexeme, valid until the next call to getNextToken
+	 */
+    const std::string &getPreviousLexeme() const;
+
+	/**
+	 * Gets the value of the previous lexeme. Only meaningful when it was a NUMBER.
+	 * @return the value
+	 */
+    int getPreviousNumber();
+
+	/**
+	 * Gets the reason the current lexeme is invalid, such as a number that does not fit in an int.
+	 * @return the message, or an empty string when there is nothing to report
+	 */
+    std::string getDiagnostic();
+
+	/**
+	 * Gets the byte offset in the file where the current lexeme starts.
+	 * @return the offset
+	 */
+    unsigned int getCurrentOffset();
+
+	/**
+	 * Gets the byte offset in the file where the previous lexeme started.
+	 * @return the offset
+	 */
+    unsigned int getPreviousOffset();
+
+	/**
+	 * Converts a byte offset into a line and column. The line table is only built on the first call. Columns count
+	 * characters, not bytes, so text after a multibyte character is still located correctly.
+	 * @param offset a byte offset in the file
+	 * @return the location
+	 */
+    SourceLocation locate(unsigned int offset);
+
+	/**
+	 * Describes where the current lexeme starts.
+	 * @return the location formatted as file:line:col
 	 */
-    std::string getCurrentLexeme();
+    std::string getCurrentLocation();
 
 	/**
 	 * Retrieves the next token in the current line
 	 * @return The Token
 	 */
 	Token getNextToken();
+
+	/**
+	 * Lexes the whole file up front so that getNextToken only hands out finished lexemes. The file is split into one
+	 * chunk per thread, but no chunk is shorter than minimumChunk, so a file shorter than twice that is lexed on one
+	 * thread. Because the only state carried between lexemes is whether the lexer is inside a quote, each
+	 * chunk is lexed speculatively both from its first byte and from just after the end of a quoted lexeme; the
+	 * chunks are then stitched together in order using whichever guess lines up with the previous chunk, re-lexing
+	 * serially where neither does. The result is exactly the serial token stream.
+	 * @param threads the number of threads to use, 1 lexes serially
+	 * @param minimumChunk the smallest number of bytes worth giving to a thread
+	 */
+	void lexAhead(unsigned int threads, unsigned int minimumChunk = defaultChunk);
+
+	/**
+	 * Starts lexing on a separate thread which hands batches of lexemes to getNextToken through a lock-free ring, so
+	 * lexing overlaps with whatever the caller does between tokens. Must be called before the first getNextToken.
+	 * @param batchSize the number of lexemes per batch
+	 * @param batches the number of batches the ring can hold before the producer has to wait
+	 */
+	void pipeline(unsigned int batchSize = 256, unsigned int batches = 64);
+
+	/**
+	 * Lexes the lexeme following another one without touching the Lexer, reusing the storage of the given lexeme so
+	 * that streaming over a file allocates nothing once the lexeme has grown to its longest. The first call should
+	 * be given getStartToken().
+	 * @param token the previous lexeme on entry, the next lexeme on return
+	 * @return false once nothing but whitespace is left
+	 */
+	bool scanNext(LexedToken &token) const;
+
+	/**
+	 * Gets a lexeme which scanNext treats as coming just before the start of the file.
+	 * @return the lexeme
+	 */
+	LexedToken getStartToken() const;
+
+	/**
+	 * Gets the text of the file.
+	 * @return the text
+	 */
+	const std::string &getSource() const;
+
+	/**
+	 * Gets the position of the current lexeme in getLexedTokens(). Only meaningful after lexAhead.
+	 * @return the position
+	 */
+	size_t getCurrentPosition() const;
+
+	/**
+	 * Skips ahead after lexAhead, as though every lexeme before position had been handed out by getNextToken.
+	 * @param position the position in getLexedTokens() of the next lexeme, at least 1
+	 * @return The Token at position
+	 */
+	Token resumeAt(size_t position);
+
+	/**
+	 * Sets the limits on this file. Must be called before lexAhead or pipeline, which do nothing for a file over the
+	 * size limit. The time limit is checked as lexemes are handed out and by the threads lexing ahead, so it bounds
+	 * the time spent on the file to within a few lexemes.
+	 * @param fileLimits the limits
+	 * @param start when the time limit starts to run
+	 */
+	void setLimits(const ParseLimits &fileLimits, std::chrono::steady_clock::time_point start);
+
+	/**
+	 * Gets the limits on this file.
+	 * @return the limits
+	 */
+	const ParseLimits &getLimits() const;
+
+	/**
+	 * Gets when the time limit started to run.
+	 * @return the time
+	 */
+	std::chrono::steady_clock::time_point getLimitStart() const;
+
+	/**
+	 * Stops the file because a limit was exceeded: the current lexeme becomes NONE and carries the diagnostic. Long
+	 * lexemes are cut short so that the output stays small.
+	 * @param diagnostic which limit was exceeded
+	 * @return NONE
+	 */
+	Token reportLimit(const std::string &diagnostic);
+
+	/**
+	 * Checks whether the time limit has run out, whether or not a lexeme has reported it yet.
+	 * @return true if there is a time limit and it has passed
+	 */
+	bool isPastDeadline() const;
+
+	/**
+	 * Checks whether a limit stopped the file.
+	 * @return true if reportLimit has been called
+	 */
+	bool isLimitReached() const;
+
+	/**
+	 * Gets the lexemes produced by lexAhead.
+	 * @return the lexemes in file order
+	 */
+	const std::vector<LexedToken> &getLexedTokens() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,221 @@
+/**
+ * @file ParseHandler.h
+ * @brief Contains the ParseHandler class, the events a BasicParser reports, and HandlerPair, which reports them to
+ * two handlers.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_PARSEHANDLER_H_H
+#define PROJECT1_PARSEHANDLER_H_H
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Lexer.h"
+
+/**
+ * @brief The kinds of error which stop a parse.
+ */
+enum ParseError
+{
+    LEXICAL_ERROR, SYNTAX_ERROR, LIMIT_ERROR
+};
+
+/**
+ * @brief The events reported by a BasicParser, each doing nothing.
+ * @details A handler derives from ParseHandler and hides the events it wants. BasicParser is templated on the
+ * handler, so events are bound at compile time and the ones left here inline away to nothing. Strings passed to an
+ * event are only valid during the call.
+ *
+ * Events for a valid file arrive in file order: onWindow, onLayout for the Window, then for each widget either
+ * onWidget, onGroupBegin with a Radio onWidget per button and onGroupEnd, or onPanelBegin, onLayout, the Panel's
+ * widgets and onPanelEnd; and finally onWindowEnd. A file that fails gets onError instead of the rest of its events.
+ * onEnter, onExit and onToken follow the grammar productions and the accepted lexemes, for handlers such as
+ * TraceHandler that report the parse itself.
+ */
+class ParseHandler
+{
+public:
+
+    /**
+     * Called once the Window header has been read.
+     * @param text the title
+     * @param width the width
+     * @param height the height
+     */
+    void onWindow(const std::string &, int, int) {}
+
+    /**
+     * Called once the layout of the Window or of the innermost Panel has been read.
+     * @param kind FLOW, BORDER or GRID
+     * @param align LEFT, RIGHT or CENTER for an aligned Flow layout, NONE otherwise
+     * @param params the numbers given to the layout
+     */
+    void onLayout(Token, Token, const std::vector<int> &) {}
+
+    /**
+     * Called when a Panel starts, before its layout.
+     */
+    void onPanelBegin() {}
+
+    /**
+     * Called at the End of a Panel.
+     */
+    void onPanelEnd() {}
+
+    /**
+     * Called when a Group starts.
+     */
+    void onGroupBegin() {}
+
+    /**
+     * Called at the End of a Group.
+     */
+    void onGroupEnd() {}
+
+    /**
+     * Called for each Button, Label, Textfield and Radio once its value has been read.
+     * @param kind BUTTON, LABEL, TEXTFIELD or RADIO
+     * @param text the text, empty for a Textfield
+     * @param number the width of a Textfield, 0 otherwise
+     */
+    void onWidget(Token, const std::string &, int) {}
+
+    /**
+     * Called at the End '.' of the Window, which completes a valid file.
+     */
+    void onWindowEnd() {}
+
+    /**
+     * Called once when the file fails.
+     * @param error what kind of error stopped the file
+     * @param location where, formatted as file:line:col
+     * @param diagnostic why the lexeme is invalid or which limit was exceeded, may be empty
+     * @param token the token the parse stopped at
+     * @param lexeme the lexeme the parse stopped at
+     */
+    void onError(ParseError, const std::string &, const std::string &, Token, const std::string &) {}
+
+    /**
+     * Called when a grammar production is entered.
+     * @param production the name of the production, e.g. "Layout Type"
+     */
+    void onEnter(const char *) {}
+
+    /**
+     * Called when a grammar production is left.
+     * @param production the name of the production
+     */
+    void onExit(const char *) {}
+
+    /**
+     * Called for each lexeme the grammar accepts, and for the lexeme a file fails at.
+     * @param token the token
+     * @param lexeme the lexeme
+     */
+    void onToken(Token, const std::string &) {}
+};
+
+/**
+ * @brief Reports every event to two handlers, the first one first.
+ */
+template<typename First, typename Second>
+class HandlerPair : public ParseHandler
+{
+protected:
+    /// The handler told first
+    First &first;
+    /// The handler told second
+    Second &second;
+
+public:
+
+    /**
+     * HandlerPair Constructor
+     * @param firstHandler the handler told first
+     * @param secondHandler the handler told second
+     * @return A HandlerPair object
+     */
+    HandlerPair(First &firstHandler, Second &secondHandler) :
+        first(firstHandler),
+        second(secondHandler)
+    {
+    }
+
+    void onWindow(const std::string &text, int width, int height)
+    {
+        first.onWindow(text, width, height);
+        second.onWindow(text, width, height);
+    }
+
+    void onLayout(Token kind, Token align, const std::vector<int> &params)
+    {
+        first.onLayout(kind, align, params);
+        second.onLayout(kind, align, params);
+    }
+
+    void onPanelBegin()
+    {
+        first.onPanelBegin();
+        second.onPanelBegin();
+    }
+
+    void onPanelEnd()
+    {
+        first.onPanelEnd();
+        second.onPanelEnd();
+    }
+
+    void onGroupBegin()
+    {
+        first.onGroupBegin();
+        second.onGroupBegin();
+    }
+
+    void onGroupEnd()
+    {
+        first.onGroupEnd();
+        second.onGroupEnd();
+    }
+
+    void onWidget(Token kind, const std::string &text, int number)
+    {
+        first.onWidget(kind, text, number);
+        second.onWidget(kind, text, number);
+    }
+
+    void onWindowEnd()
+    {
+        first.onWindowEnd();
+        second.onWindowEnd();
+    }
+
+    void onError(ParseError error, const std::string &location, const std::string &diagnostic, Token token,
+                 const std::string &lexeme)
+    {
+        first.onError(error, location, diagnostic, token, lexeme);
+        second.onError(error, location, diagnostic, token, lexeme);
+    }
+
+    void onEnter(const char *production)
+    {
+        first.onEnter(production);
+        second.onEnter(production);
+    }
+
+    void onExit(const char *production)
+    {
+        first.onExit(production);
+        second.onExit(production);
+    }
+
+    void onToken(Token token, const std::string &lexeme)
+    {
+        first.onToken(token, lexeme);
+        second.onToken(token, lexeme);
+    }
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file ParseRun.cpp
+ * @brief Contains the source code for parsing a file in any mode of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "CodeGenerator.h"
+#include "ParseRun.h"
+
+using namespace std;
+
+/**
+ * Writes the generated header for a successfully parsed file, reporting why if it cannot be generated.
+ * @param parser the parser which has parsed the file
+ * @param inputFile the file that was parsed
+ * @param generateDirectory the directory to hold the header
+ * @param consoleLock guards the console
+ */
+static void write_generated_header(const Parser &parser, const std::experimental::filesystem::path &inputFile,
+                                   const string &generateDirectory, mutex &consoleLock) {
+    string name(CodeGenerator::identifierFor(inputFile));
+    std::experimental::filesystem::path header(std::experimental::filesystem::path(generateDirectory) / (name + ".h"));
+    // one header that cannot be written should not stop the rest of a directory
+    string message;
+    try {
+        CodeGenerator generator(parser.getDescriptor(), name, inputFile.filename().string());
+        if (generator.writeFile(header)) {
+            message = "Generated " + header.string();
+        }
+    }
+    catch (runtime_error &e) {
+        message = "Cannot generate " + header.string() + ": " + e.what();
+    }
+    if (!message.empty()) {
+        lock_guard<mutex> guard(consoleLock);
+        cout << message << endl;
+    }
+}
+
+void write_allocations(const string &name, const AllocationLedger &ledger) {
+    static const char *const phaseNames[PHASE_COUNT] = { "lexer", "parser", "output" };
+    cout << "Memory " << name << ":";
+    for (int phase = 0; phase <= PHASE_COUNT; ++phase) {
+        AllocationCounts counts(phase == PHASE_COUNT ? ledger.getTotal()
+                                                     : ledger.getCounts(static_cast<AllocationPhase>(phase)));
+        cout << (phase == 0 ? " " : ", ") << (phase == PHASE_COUNT ? "total" : phaseNames[phase]) << " "
+            << counts.allocations << " allocs " << counts.bytes << " bytes " << std::max(0LL, counts.peak)
+            << " peak";
+    }
+    cout << endl;
+}
+
+std::experimental::filesystem::path output_path_for(const string &outputDirectory,
+                                                    const std::experimental::filesystem::path &relative) {
+    std::experimental::filesystem::path outfile(outputDirectory);
+    outfile /= relative.parent_path();
+    outfile /= "OUTPUT_" + relative.filename().string();
+    return outfile;
+}
+
+bool run_parser(Parser &parser, const std::experimental::filesystem::path &inputFile, const RunOptions &options,
+                mutex &consoleLock) {
+    parser.setLimits(options.limits);
+    if (options.panelThreads) {
+        parser.parallelPanels(options.panelThreads, options.lexChunk);
+    }
+    else if (options.lexThreads) {
+        parser.lexAhead(options.lexThreads, options.lexChunk);
+    }
+    else if (options.pipeline) {
+        parser.pipeline();
+    }
+    bool valid = parser.file();
+    if (valid && options.generate) {
+        write_generated_header(parser, inputFile, options.generateDirectory, consoleLock);
+    }
+    return valid;
+}
+
+bool parse_loaded_file(LoadedFile &file, const string &outputDirectory, const RunOptions &options, bool print,
+                       StringTable &strings, AllocationLedger *ledger, CorpusStats *stats,
+                       CorpusIndexBuilder *index, mutex &consoleLock) throw(runtime_error) {
+    std::experimental::filesystem::path outfile(output_path_for(outputDirectory, file.relative));
+    if (print) {
+        cout << "\n\n*******************************************************\nPARSING: "
+            << file.path
+            << "\n*******************************************************\n\n\n" << endl;;
+    }
+    if (!file.error.empty()) {
+        throw runtime_error(file.error);
+    }
+    if (file.relative.has_parent_path()) {
+        experimental::filesystem::create_directories(outfile.parent_path());
+    }
+    AllocationScope fileScope(ledger, PARSE_PHASE);
+    unsigned long long bytes = file.bytes;
+    auto start = chrono::steady_clock::now();
+    Parser parser(file.path, std::move(file.contents), outfile.string(), print, &strings, bytes);
+    bool valid = run_parser(parser, file.path, options, consoleLock);
+    if (stats != nullptr) {
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        stats->addFile(parser.getDescriptor(), valid, bytes, elapsed.count());
+    }
+    if (valid && index != nullptr) {
+        index->add(file.path.string(), parser.getDescriptor());
+    }
+    string limit(parser.getLimitDiagnostic());
+    if (!limit.empty()) {
+        lock_guard<mutex> guard(consoleLock);
+        cout << "Stopped " << file.relative.generic_string() << ": " << limit << endl;
+    }
+    return valid;
+}
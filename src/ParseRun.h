@@ -0,0 +1,114 @@
+/**
+ * @file ParseRun.h
+ * @brief Contains the options of a run and the functions every mode of the driver uses to parse a file.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_PARSERUN_H_H
+#define PROJECT1_PARSERUN_H_H
+
+#pragma once
+
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "CorpusIndex.h"
+#include "CorpusStats.h"
+#include "FileLoader.h"
+#include "Parser.h"
+#include "StringTable.h"
+
+/**
+ * @brief Options which apply to every file parsed in a run.
+ */
+struct RunOptions
+{
+    /// Write a generated header for each valid file
+    bool generate;
+    /// Where generated headers are written
+    std::string generateDirectory;
+    /// Lex each file up front with this many threads, 0 to lex on demand
+    unsigned int lexThreads;
+    /// The fewest bytes given to each thread lexing a file up front
+    unsigned int lexChunk;
+    /// Lex on a separate thread ahead of the parser
+    bool pipeline;
+    /// Parse separate Panels on this many threads, 0 to parse sequentially
+    unsigned int panelThreads;
+    /// The limits on each file
+    ParseLimits limits;
+};
+
+/**
+ * @brief Which files below a directory a run works on, and how they are read.
+ */
+struct DirectoryOptions
+{
+    /// The directory searched for input files
+    std::string directory;
+    /// Only files matching one of these globs are used, all files if empty
+    std::vector<std::string> includes;
+    /// Files matching one of these globs are skipped
+    std::vector<std::string> excludes;
+    /// The number of threads reading files ahead
+    unsigned int readers;
+    /// The most files read ahead and waiting
+    unsigned int prefetch;
+    /// The number of files worked on at once
+    unsigned int jobs;
+};
+
+/**
+ * Writes one line of allocation counts.
+ * @param name what the counts belong to
+ * @param ledger the counts
+ */
+void write_allocations(const std::string &name, const AllocationLedger &ledger);
+
+/**
+ * Works out where the output of an input file found below a directory goes, mirroring its sub-directory.
+ * @param outputDirectory the output directory
+ * @param relative the input file relative to the directory it was found in
+ * @return the output file
+ */
+std::experimental::filesystem::path output_path_for(const std::string &outputDirectory,
+                                                    const std::experimental::filesystem::path &relative);
+
+/**
+ * Parses one file and writes its generated header when requested.
+ * @param parser the parser for the file
+ * @param inputFile the file being parsed
+ * @param options the run options
+ * @param consoleLock guards the console, which reports the generated header
+ * @return true if the file is valid
+ */
+bool run_parser(Parser &parser, const std::experimental::filesystem::path &inputFile, const RunOptions &options,
+                std::mutex &consoleLock);
+
+/**
+ * Parses one file found below a directory, writing its output below the output directory.
+ * @param file the file and its contents, which are moved into the parser
+ * @param outputDirectory the output directory
+ * @param options the run options
+ * @param print print the output to the screen too
+ * @param strings the table the texts of the widget tree are interned in
+ * @param ledger receives the allocations made for the file, null when not counting them
+ * @param stats receives the statistics of the file, null when not collecting them
+ * @param index receives the descriptor of a valid file, null when not indexing
+ * @param consoleLock guards the console
+ * @return true if the file is valid
+ * @throw runtime_error if the file could not be read or its output could not be written
+ */
+bool parse_loaded_file(LoadedFile &file, const std::string &outputDirectory, const RunOptions &options, bool print,
+                       StringTable &strings, AllocationLedger *ledger, CorpusStats *stats,
+                       CorpusIndexBuilder *index, std::mutex &consoleLock) throw(std::runtime_error);
+
+#endif //PROJECT1_PARSERUN_H_H
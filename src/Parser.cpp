@@ -5,282 +5,205 @@
  * @date November 20, 2016
  */
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <tuple>
 //#include <string>
 
+#include "AllocationTracker.h"
 #include "Lexer.h"
 #include "Parser.h"
 #include "stringhelper.h"
 
 using namespace std;
 
-/**
- * @def WRITE_LINE
- * Writes a string to to the parser's ofstream, also prints to stdout if print is true.
- * @param writevalue
- */
-#define WRITE_LINE(writevalue) \
-    if(print){\
-        cout << writevalue << endl;\
-    }\
-    outfile << writevalue << endl;
-
-/**
- * @def PARSER_CHECK
- * takes a conditional that compares the current token to the expected token value. If the token is valid syntactically
- * then the process continues by writing the values and getting the next token. Otherwise the process fails.
- */
-#define PARSER_CHECK(COND) \
-    if(COND){ \
-        writeTokenLexeme(token, lexer.getCurrentLexeme());\
-        token = lexer.getNextToken(); \
-    } \
-    else{ \
-        ret = false;\
-        goto cleanup;\
-    }
+Parser::Recorder::Recorder(Parser &owner) :
+    HandlerPair<TraceHandler, DescriptorHandler>(owner.trace, owner.tree),
+    parser(owner)
+{
+}
 
-/**
- * @def PRODUCTION_CHECK
- * takes a conditional that compares whether a production function succeeded or not.
- */
-#define PRODUCTION_CHECK(COND)\
-    if(!COND){\
-        ret = false;\
-        goto cleanup;\
-    }
+bool Parser::Recorder::replayPanel(Token &token) {
+    return !parser.fragments.empty() && parser.spliceFragment(token);
+}
 
-void Parser::writeTokenLexeme(Token token, string lexeme){
-    string writeline("Next Token is: " + std::to_string(token) + "; Next Lexeme is: " + lexeme);
-    if (print) {
-        cout << writeline << endl;
+Parser::Parser(std::experimental::filesystem::path infilename, std::string outfilename, bool printval,
+               StringTable *table, unsigned int maxBytes) throw(runtime_error): 
+    outfile(outfilename),
+    out(outfile),
+    lexer(infilename, maxBytes),
+    print(printval),
+    trace(out, print),
+    ownStrings(table == nullptr ? new StringTable() : nullptr),
+    strings(table == nullptr ? *ownStrings : *table),
+    tree(strings),
+    events(*this),
+    grammar(lexer, events),
+    nextFragment(0)
+{
+    lexer.getCurrentLexeme();
+    if (!outfile.is_open()) {
+        throw runtime_error("Invalid path to output file");
     }
-    outfile << writeline << endl;
 }
 
-Parser::Parser(std::experimental::filesystem::path infilename, std::string outfilename, bool printval) throw(runtime_error): 
+Parser::Parser(std::experimental::filesystem::path infilename, std::string contents, std::string outfilename,
+               bool printval, StringTable *table, unsigned long long bytes) throw(runtime_error): 
     outfile(outfilename),
-    lexer(infilename)
+    out(outfile),
+    lexer(infilename, std::move(contents), bytes),
+    print(printval),
+    trace(out, print),
+    ownStrings(table == nullptr ? new StringTable() : nullptr),
+    strings(table == nullptr ? *ownStrings : *table),
+    tree(strings),
+    events(*this),
+    grammar(lexer, events),
+    nextFragment(0)
 {
     lexer.getCurrentLexeme();
-    token = NONE;
-    print = printval;
     if (!outfile.is_open()) {
         throw runtime_error("Invalid path to output file");
     }
 }
 
-void Parser::file() {
-    token = lexer.getNextToken();
-    bool finaltest = gui_production();
+Parser::Parser(std::vector<LexedToken> tokens, StringTable &table) :
+    out(fragmentOut),
+    lexer(std::move(tokens)),
+    print(false),
+    trace(out, print),
+    strings(table),
+    tree(strings),
+    events(*this),
+    grammar(lexer, events),
+    nextFragment(0)
+{
 }
 
-bool Parser::gui_production(){
-    bool ret = true;
-    WRITE_LINE("Entering GUI Production");
-
-    PARSER_CHECK(token == WINDOW);
-
-    PARSER_CHECK(token == STRING);
-
-    PARSER_CHECK(token == OPENPAREN);
-
-    PARSER_CHECK(token == NUMBER);
-
-    PARSER_CHECK(token == COMMA);
-
-    PARSER_CHECK(token == NUMBER);
-
-    PARSER_CHECK(token == CLOSEPAREN);
-
-    PRODUCTION_CHECK(layout_production());
-
-    widgets_production();
-
-    PARSER_CHECK(token == END);
-
-    // At end of file so we can't use PARSER_CHECK which tries to get another token
-    // should fix this in case a file has more after the end of the production
-    if (token == PERIOD) {
-        writeTokenLexeme(token, lexer.getCurrentLexeme()); 
-    } 
-    else {
-        ret = false; 
-        goto cleanup; 
-    }
-cleanup:
-    if (ret == false){
-        if (token == NONE) {
-            
-            WRITE_LINE("******** Lexical Error!! ********");
-            writeTokenLexeme(token, lexer.getCurrentLexeme());
-        }
-        else {
-            WRITE_LINE("******** Syntax Error!! ********");
-            writeTokenLexeme(token, lexer.getCurrentLexeme());
-        }
-    }
-    WRITE_LINE("Exiting GUI Production");
-    return ret;
+void Parser::setLimits(const ParseLimits &limits) {
+    lexer.setLimits(limits, chrono::steady_clock::now());
 }
 
-bool Parser::layout_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Layout Production");
-    PARSER_CHECK(token == LAYOUT);
-
-    PRODUCTION_CHECK(layout_type_production());
-
-    PARSER_CHECK(token == COLON);
-
-cleanup:
-    WRITE_LINE("Exiting Layout Production");
-    return ret;
+std::string Parser::getLimitDiagnostic() {
+    return lexer.isLimitReached() ? lexer.getDiagnostic() : string();
 }
 
-bool Parser::layout_type_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Layout Type Production")
-
-    Token type = token;
-    PARSER_CHECK(token == FLOW || token == BORDER || token == GRID);
+void Parser::lexAhead(unsigned int threads, unsigned int minimumChunk) {
+    lexer.lexAhead(threads, minimumChunk);
+}
 
-    PARSER_CHECK(token == OPENPAREN);
+void Parser::pipeline() {
+    lexer.pipeline();
+}
 
-    switch(type){
-        case FLOW: {
-            if (token != CLOSEPAREN) {
-                PRODUCTION_CHECK(align_production());
-            }
-            break;
+void Parser::parallelPanels(unsigned int threads, unsigned int minimumChunk, size_t minimumTokens) {
+    lexer.lexAhead(threads, minimumChunk);
+    const vector<LexedToken> &tokens = lexer.getLexedTokens();
+
+    // Pre-scan: match every Panel and Group with its End. Groups are tracked so their Ends are not taken for a
+    // Panel's. Spans are found innermost first, so sort them into file order, where a Panel precedes its children.
+    // Each span also records how many nodes are open around it, counting the Window.
+    vector<tuple<size_t, size_t, unsigned int>> spans;
+    vector<size_t> open;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (tokens[i].token == PANEL || tokens[i].token == GROUP) {
+            open.push_back(i);
         }
-        case BORDER:{
-            if(token != CLOSEPAREN) {
-                PARSER_CHECK(token == NUMBER);
-
-                PARSER_CHECK(token == COMMA);
-
-                PARSER_CHECK(token == NUMBER);
+        else if (tokens[i].token == END && !open.empty()) {
+            size_t first = open.back();
+            open.pop_back();
+            if (tokens[first].token == PANEL && i + 1 < tokens.size() && tokens[i + 1].token == SEMICOLON) {
+                spans.push_back(make_tuple(first, i + 1, static_cast<unsigned int>(open.size()) + 1));
             }
-            break;
         }
-        case GRID:{
-            PARSER_CHECK(token == NUMBER);
-
-            PARSER_CHECK(token == COMMA);
-
-            PARSER_CHECK(token == NUMBER);
-            if(token != CLOSEPAREN) {
-                PARSER_CHECK(token == COMMA);
-
-                PARSER_CHECK(token == NUMBER);
-
-                PARSER_CHECK(token == COMMA);
+    }
+    std::sort(spans.begin(), spans.end());
+    // out of time already: file() reports the limit on its own within a few lexemes
+    if (lexer.isPastDeadline()) {
+        return;
+    }
 
-                PARSER_CHECK(token == NUMBER);
-            }
-            break;
+    // Take the outermost Panels that are small enough to leave work for every thread, or that have no Panels
+    // inside to split further. Whatever is not taken is parsed by file() as usual.
+    size_t target = std::max(minimumTokens, tokens.size() / (std::max(1u, threads) * 4));
+    size_t covered = 0;
+    fragments.clear();
+    for (size_t s = 0; s < spans.size(); ++s) {
+        size_t first = get<0>(spans[s]);
+        size_t last = get<1>(spans[s]);
+        size_t length = last - first + 1;
+        bool hasInnerPanel = s + 1 < spans.size() && get<0>(spans[s + 1]) < last;
+        if ((fragments.empty() || first > covered) && length >= minimumTokens
+            && (length <= target || !hasInnerPanel)) {
+            Fragment fragment;
+            fragment.first = first;
+            fragment.last = last;
+            fragment.depth = get<2>(spans[s]);
+            fragment.valid = false;
+            fragments.push_back(std::move(fragment));
+            covered = last;
         }
     }
 
-    PARSER_CHECK(token == CLOSEPAREN);
-
-cleanup:
-    WRITE_LINE("Exiting Layout Type Production");
-    return ret;
-}
-
-bool Parser::align_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Align Production");
-
-    PARSER_CHECK(token == LEFT || token == RIGHT || token == CENTER);
-
-cleanup:
-    WRITE_LINE("Exiting Align Production");
-    return ret;
-}
-
-bool Parser::widget_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Widget Production");
-
-    switch(token){
-        case BUTTON:{
-            PARSER_CHECK(token == BUTTON);
-            PARSER_CHECK(token == STRING);
-            break;
-        }
-        case LABEL:{
-            PARSER_CHECK(token == LABEL);
-            PARSER_CHECK(token == STRING);
-            break;
-        }
-        case GROUP:{
-            PARSER_CHECK(token == GROUP);
-            radio_buttons_production();
-            PARSER_CHECK(token == END);
-            break;
-        }
-        case PANEL:{
-            PARSER_CHECK(token == PANEL);
-            PRODUCTION_CHECK(layout_production());
-            widgets_production();
-            PARSER_CHECK(token == END);
-            break;
-        }
-        case TEXTFIELD:{
-            PARSER_CHECK(token == TEXTFIELD);
-            PARSER_CHECK(token == NUMBER);
-            break;
-        }
-        default:{
-            ret = false;
-            goto cleanup;
+    AllocationLedger *ledger = AllocationScope::currentLedger();
+    atomic<size_t> next(0);
+    auto parseFragments = [&]() {
+        AllocationScope scope(ledger, PARSE_PHASE);
+        for (size_t f = next++; f < fragments.size() && !lexer.isPastDeadline(); f = next++) {
+            Fragment &fragment = fragments[f];
+            Parser parser(vector<LexedToken>(tokens.begin() + fragment.first, tokens.begin() + fragment.last + 1),
+                          strings);
+            parser.lexer.setLimits(lexer.getLimits(), lexer.getLimitStart());
+            parser.grammar.setBaseDepth(fragment.depth);
+            // the subtree is only usable if it parsed and ended exactly on its closing ';'
+            fragment.valid = parser.grammar.widget()
+                && parser.lexer.getPreviousOffset() == tokens[fragment.last].offset;
+            fragment.trace = parser.fragmentOut.str();
+            fragment.descriptor = std::move(parser.tree.descriptor);
         }
+    };
+    vector<thread> workers;
+    for (unsigned int i = 1; i < threads && i < fragments.size(); ++i) {
+        workers.emplace_back(parseFragments);
     }
-
-    PARSER_CHECK(token == SEMICOLON);
-
-cleanup:
-    WRITE_LINE("Exiting Widget Production");
-    return ret;
+    parseFragments();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    nextFragment = 0;
 }
 
-bool Parser::widgets_production(){
-    bool ret = true;
-
-    WRITE_LINE("Entering Widgets Production");
-    PRODUCTION_CHECK(widget_production());
-    PRODUCTION_CHECK(widgets_production());
-
-cleanup:
-    WRITE_LINE("Exiting Widgets Production");
-    return ret;
+bool Parser::spliceFragment(Token &token) {
+    size_t position = lexer.getCurrentPosition();
+    while (nextFragment < fragments.size() && fragments[nextFragment].first < position) {
+        ++nextFragment;
+    }
+    if (nextFragment == fragments.size() || fragments[nextFragment].first != position) {
+        return false;
+    }
+    Fragment &fragment = fragments[nextFragment++];
+    // a sequential parse of the subtree would have handed out every lexeme up to the one after its ';', so leave
+    // it to that parse to report the token limit, and likewise the depth limit if the pre-scan guessed wrong
+    unsigned int maxTokens = lexer.getLimits().maxTokens;
+    if (!fragment.valid || (maxTokens && fragment.last + 2 > maxTokens)
+        || fragment.depth != tree.descriptor.depth()) {
+        return false;
+    }
+    trace.writeRecorded(fragment.trace);
+    tree.descriptor.splice(fragment.descriptor);
+    token = lexer.resumeAt(fragment.last + 1);
+    return true;
 }
 
-bool Parser::radio_buttons_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Radio Buttons Production");
-    PRODUCTION_CHECK(radio_button_production());
-    radio_buttons_production();
-
-
-cleanup:
-    WRITE_LINE("Exiting Radio Buttons Production");
-    return ret;
+bool Parser::file() {
+    AllocationScope scope(PARSE_PHASE);
+    return grammar.file();
 }
 
-bool Parser::radio_button_production(){
-    bool ret = true;
-    WRITE_LINE("Entering Radio Button Production" );
-    PARSER_CHECK(token == RADIO);
-    PARSER_CHECK(token == STRING);
-    PARSER_CHECK(token == SEMICOLON);
-
-cleanup:
-    WRITE_LINE("Exiting Radio Button Production" );
-    return ret;
-}
\ No newline at end of file
+const Descriptor &Parser::getDescriptor() const {
+    return tree.descriptor;
+}
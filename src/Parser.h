@@ -9,12 +9,23 @@
 #define PROJECT1_PARSER_H_H
 
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "BasicParser.h"
+#include "Descriptor.h"
+#include "DescriptorHandler.h"
 #include "Lexer.h"
+#include "StringTable.h"
+#include "TraceHandler.h"
 
 /**
  * @brief The parser class parses a specific grammar.
  * @details The Parser class is used to parse each Token created by the Lexer class and to parse the overall syntax of
  * the grammar:\n
+ * The productions themselves are a BasicParser; Parser writes their trace with a TraceHandler, records the widget tree
+ * with a DescriptorHandler and adds the ways of lexing and parsing ahead on other threads.\n
  *  gui ::= Window STRING '(' NUMBER ',' NUMBER ')' layout widgets End '.'\n
     layout ::= Layout layout_type ':'\n
     layout_type ::=\n
@@ -33,14 +44,87 @@
     radio_button ::= Radio STRING ';'\n
  */
 class Parser{
+    /**
+     * @brief A Panel subtree parsed ahead of time on another thread.
+     */
+    struct Fragment
+    {
+        /// Position of the Panel token in the lexed tokens
+        size_t first;
+        /// Position of the ';' closing the Panel
+        size_t last;
+        /// The number of nodes open around the Panel, counting the Window
+        unsigned int depth;
+        /// true if the subtree parsed without error
+        bool valid;
+        /// The output written while parsing the subtree
+        std::string trace;
+        /// The nodes recorded while parsing the subtree
+        Descriptor descriptor;
+    };
+
+    /**
+     * @brief Reports the events of the parse to the trace and the tree, and splices in Panels parsed ahead of time.
+     */
+    class Recorder : public HandlerPair<TraceHandler, DescriptorHandler>
+    {
+    private:
+        /// The parser whose fragments are spliced
+        Parser &parser;
+
+        friend struct PanelReplay<Recorder>;
+
+        /**
+         * Splices in the Panel about to be parsed when it was parsed ahead of time.
+         * @param token receives the token after the Panel when it is spliced
+         * @return true if the Panel was spliced
+         */
+        bool replayPanel(Token &token);
+
+    public:
+
+        /**
+         * Recorder Constructor
+         * @param owner the parser whose trace and tree receive the events
+         * @return A Recorder object
+         */
+        explicit Recorder(Parser &owner);
+    };
+
     /// The output file stream associated with the current Lexer input file stream.
     std::ofstream outfile;
+    /// Collects the output of a Parser working on a fragment
+    std::ostringstream fragmentOut;
+    /// Where output is written, outfile or fragmentOut
+    std::ostream &out;
     /// The lexer which will provide tokens and lexemes
     Lexer lexer;
-    /// A token whose value will be proviced by the Lexer class
-    Token token;
     /// This value indicates whether or not the parser will print its output
     bool print;
+    /// Writes the trace of the parse to out
+    TraceHandler trace;
+    /// The table of a parser that was not given one
+    std::unique_ptr<StringTable> ownStrings;
+    /// The table the texts of the widget tree are interned in
+    StringTable &strings;
+    /// Records the widget tree while parsing
+    DescriptorHandler tree;
+    /// Passes the events of the parse to trace and tree
+    Recorder events;
+    /// The productions of the grammar
+    BasicParser<Recorder> grammar;
+    /// Panel subtrees parsed ahead of time, in file order
+    std::vector<Fragment> fragments;
+    /// The first entry of fragments the parse has not reached yet
+    size_t nextFragment;
+
+    /**
+     * The Parser constructor for a fragment, which parses a single Panel widget from lexemes lexed elsewhere.
+     * @param tokens the lexemes from the Panel to its closing ';'
+     * @param strings the table of the parser the Panel belongs to
+     * @return A parser object
+     */
+    Parser(std::vector<LexedToken> tokens, StringTable &strings);
 
 public:
     /**
@@ -48,72 +132,89 @@ public:
      * @param inFilename a path to the current file to be parsed and lexed
      * @param outfile the name of the file which will contain the output of the parser
      * @param print Print output or not
+     * @param strings a table shared by all parsers in a run which interns the texts of the widget tree, or null for
+     * one of the parser's own
+     * @param maxBytes a file larger than this is not read, and is stopped once setLimits applies the same limit; 0
+     * reads any file
      * @return A parser object
      * @throw runtime_error
      */
-    Parser(std::experimental::filesystem::path inFilename, std::string outfile, bool print) throw(std::runtime_error);
+    Parser(std::experimental::filesystem::path inFilename, std::string outfile, bool print,
+           StringTable *strings = nullptr, unsigned int maxBytes = 0) throw(std::runtime_error);
 
     /**
-     * Begins the process of parsing the input file
+     * The Parser constructor for a file that has already been read
+     * @param inFilename the path of the file, used in diagnostics
+     * @param contents the text of the file
+     * @param outfile the name of the file which will contain the output of the parser
+     * @param print Print output or not
+     * @param strings a table shared by all parsers in a run which interns the texts of the widget tree, or null for
+     * one of the parser's own
+     * @param bytes the size of the file when it was too large to read and contents is empty, otherwise 0
+     * @return A parser object
+     * @throw runtime_error
      */
-    void file();
-
-private:
+    Parser(std::experimental::filesystem::path inFilename, std::string contents, std::string outfile, bool print,
+           StringTable *strings = nullptr, unsigned long long bytes = 0) throw(std::runtime_error);
 
     /**
-     * Validates the gui production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Sets the limits on the file, starting its time limit now. A file which exceeds one stops with a diagnostic
+     * as though it had a lexical error. Must be called before lexAhead, pipeline, parallelPanels and file().
+     * @param limits the limits
      */
-    bool gui_production();
+    void setLimits(const ParseLimits &limits);
 
     /**
-     * Validates the layout production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Gets why a limit stopped the file.
+     * @return the diagnostic, empty if no limit was exceeded
      */
-    bool layout_production();
+    std::string getLimitDiagnostic();
 
     /**
-     * Validates the layout type production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Lexes the whole input file before parsing, splitting the work across threads. Must be called before file().
+     * @param threads the number of threads to lex with
+     * @param minimumChunk the fewest bytes given to a thread, so a file shorter than twice this is lexed on one thread
      */
-    bool layout_type_production();
+    void lexAhead(unsigned int threads, unsigned int minimumChunk = Lexer::defaultChunk);
 
     /**
-     * Validates the align production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Lexes on a separate thread which stays ahead of the parser, handing over tokens in batches. Must be called
+     * before file().
      */
-    bool align_production();
+    void pipeline();
 
     /**
-     * Validates the widget production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Lexes the whole file, then finds Panels by matching each Panel and Group with its End and parses separate
+     * Panel subtrees on a pool of threads. file() splices each finished subtree, output included, in place of
+     * parsing it, and parses a subtree itself if it failed, so the result is exactly that of a sequential parse.
+     * Must be called before file().
+     * @param threads the number of threads to lex and parse with
+     * @param minimumChunk the fewest bytes given to a thread lexing the file
+     * @param minimumTokens the fewest lexemes in a subtree worth handing to another thread
      */
-
-    bool widget_production();
-
-    /**
-    * Validates the widgets production syntax.
-    * @return true if syntax is valid, false otherwise
-    */
-    bool widgets_production();
+    void parallelPanels(unsigned int threads, unsigned int minimumChunk = Lexer::defaultChunk,
+                        size_t minimumTokens = 256);
 
     /**
-     * Validates the radio buttons production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Begins the process of parsing the input file
+     * @return true if the whole file is syntactically valid, false otherwise
      */
-    bool radio_buttons_production();
+    bool file();
 
     /**
-     * Validates the radio button production syntax.
-     * @return true if syntax is valid, false otherwise
+     * Gets the widget tree recorded by file(). It is only complete when file() returned true.
+     * @return the descriptor
      */
-    bool radio_button_production();
+    const Descriptor &getDescriptor() const;
+
+private:
 
     /**
-     * Writes the next token and lexeme to the output file, prints the output to screen if print is true.
-     * @param token the available token
-     * @param lexeme the available lexeme
+     * Replaces parsing the current widget with a fragment parsed ahead of time, if there is a valid one starting at
+     * the current token.
+     * @param token receives the token after the fragment when it is spliced in
+     * @return true if a fragment was spliced in
      */
-    void writeTokenLexeme(Token token, std::string lexeme);
+    bool spliceFragment(Token &token);
 };
 #endif //PROJECT1_PARSER_H_H
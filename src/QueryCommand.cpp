@@ -0,0 +1,41 @@
+/**
+ * @file QueryCommand.cpp
+ * @brief Contains the source code for the query command of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CorpusIndex.h"
+#include "QueryCommand.h"
+
+using namespace std;
+
+int run_query(int argc, char *argv[]) {
+    if (argc < 4) {
+        cout << "query requires an index and at least one clause" << endl;
+        return 1;
+    }
+    try {
+        auto start = chrono::steady_clock::now();
+        CorpusIndex index(argv[2]);
+        vector<string> matched(index.query(vector<string>(argv + 3, argv + argc)));
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        for (const string &path : matched) {
+            cout << path << "\n";
+        }
+        cout << matched.size() << " of " << index.fileCount() << " files matched in " << fixed << setprecision(3)
+            << elapsed.count() << " ms" << endl;
+    }
+    catch (runtime_error &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
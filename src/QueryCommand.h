@@ -0,0 +1,20 @@
+/**
+ * @file QueryCommand.h
+ * @brief Contains the query command of the driver, which searches an index written by --index.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_QUERYCOMMAND_H_H
+#define PROJECT1_QUERYCOMMAND_H_H
+
+#pragma once
+
+/**
+ * Runs the query command: prints the files of an index which match every clause.
+ * @param argc number of arguments
+ * @param argv the arguments, argv[2] is the index and the rest are clauses
+ * @return the exit code
+ */
+int run_query(int argc, char *argv[]);
+
+#endif //PROJECT1_QUERYCOMMAND_H_H
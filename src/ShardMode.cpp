@@ -0,0 +1,110 @@
+/**
+ * @file ShardMode.cpp
+ * @brief Contains the source code for the --shards mode of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "FileLoader.h"
+#include "ShardMode.h"
+#include "ShardRunner.h"
+#include "StringTable.h"
+
+using namespace std;
+
+bool run_shards(const DirectoryOptions &directory, unsigned int shards, const string &outputDirectory,
+                const RunOptions &options, AllocationLedger *ledger, CorpusStats *stats) throw(runtime_error) {
+    ShardRunner runner(FileLoader::find(directory.directory, directory.includes, directory.excludes), shards);
+    cout << "Parsing " << runner.getManifest().size() << " files in " << runner.getShardCount() << " shards" << endl;
+    // each worker interns into its own copy of this table, which is still empty when the workers start
+    StringTable strings;
+    mutex consoleLock;
+    // runs in each worker: parse a file at a time and report what the parent needs to total the run
+    auto work = [&](vector<LoadedFile> files, const ShardRunner::Report &report) {
+        FileLoader loader(std::move(files), directory.readers, directory.prefetch, options.limits.maxBytes);
+        LoadedFile file;
+        while (loader.next(file)) {
+            std::experimental::filesystem::path relative(file.relative);
+            unsigned long long requests = strings.getRequests();
+            unsigned long long distinct = strings.getDistinct();
+            unsigned long long held = strings.getMemoryBytes();
+            unsigned long long copies = strings.getCopyBytes();
+            AllocationLedger fileLedger;
+            CorpusStats fileStats;
+            int outcome = 2;
+            try {
+                outcome = parse_loaded_file(file, outputDirectory, options, false, strings,
+                                            ledger ? &fileLedger : nullptr, stats ? &fileStats : nullptr, nullptr,
+                                            consoleLock) ? 1 : 0;
+                if (ledger) {
+                    write_allocations(relative.generic_string(), fileLedger);
+                }
+            }
+            catch (runtime_error &e) {
+                cout << "Caught Exception: " << e.what() << endl;
+            }
+            ostringstream record;
+            record << outcome << " " << strings.getRequests() - requests << " " << strings.getDistinct() - distinct
+                << " " << strings.getMemoryBytes() - held << " " << strings.getCopyBytes() - copies << "\n";
+            if (ledger) {
+                fileLedger.save(record);
+            }
+            if (stats) {
+                fileStats.save(record);
+            }
+            report(relative, record.str());
+        }
+    };
+    // outcomes[0] counts invalid files, [1] valid files, [2] files that could not be parsed
+    unsigned long long outcomes[3] = { 0, 0, 0 };
+    // the string counts of every file: requests, distinct strings within its shard, the bytes the table grew by and
+    // the bytes copies of its strings would have held
+    unsigned long long shardStrings[4] = { 0, 0, 0, 0 };
+    auto collect = [&](const ShardFile &file, const string &record) {
+        istringstream in(record);
+        int outcome = -1;
+        unsigned long long requests = 0;
+        unsigned long long distinct = 0;
+        unsigned long long held = 0;
+        unsigned long long copies = 0;
+        AllocationLedger fileLedger;
+        CorpusStats fileStats;
+        if (!(in >> outcome >> requests >> distinct >> held >> copies) || outcome < 0 || outcome > 2
+            || (ledger && !fileLedger.load(in)) || (stats && !fileStats.load(in))) {
+            cout << "Caught Exception: Unreadable result for " << file.relative.generic_string() << endl;
+            ++outcomes[2];
+            return;
+        }
+        ++outcomes[outcome];
+        shardStrings[0] += requests;
+        shardStrings[1] += distinct;
+        shardStrings[2] += held;
+        shardStrings[3] += copies;
+        if (ledger) {
+            ledger->merge(fileLedger);
+        }
+        if (stats) {
+            stats->merge(fileStats);
+        }
+    };
+    unsigned long long crashed = 0;
+    auto lost = [&](const ShardFile &file, const string &reason) {
+        cout << "Crashed " << file.relative.generic_string() << ": " << reason << endl;
+        ++crashed;
+    };
+    runner.run(work, collect, lost);
+    cout << "Shards: " << outcomes[1] << " valid, " << outcomes[0] << " invalid, " << outcomes[2]
+        << " could not be parsed, " << crashed << " crashed; " << runner.getFailedShards()
+        << " shards failed and " << runner.getRetriedFiles() << " of their files were retried" << endl;
+    cout << "Strings: " << shardStrings[0] << " interned, " << shardStrings[1] << " distinct within shards ("
+        << (shardStrings[1] == 0 ? 1.0 : static_cast<double>(shardStrings[0]) / shardStrings[1]) << "x dedup), "
+        << shardStrings[2] << " bytes held by the shard tables, "
+        << static_cast<long long>(shardStrings[3] - shardStrings[0] * sizeof(const string *) - shardStrings[2])
+        << " bytes saved over a copy per widget" << endl;
+    return outcomes[2] > 0 || crashed > 0;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file ShardMode.h
+ * @brief Contains the --shards mode of the driver, which parses a directory in separate worker processes.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_SHARDMODE_H_H
+#define PROJECT1_SHARDMODE_H_H
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "AllocationTracker.h"
+#include "CorpusStats.h"
+#include "ParseRun.h"
+
+/**
+ * Parses the selected files below a directory in shards of about the same size, each in a process of its own, and
+ * prints what happened to them and the string counts of the workers' tables.
+ * @param directory the files to parse and how each worker reads them; jobs is not used, as a worker parses a file
+ * at a time
+ * @param shards the number of shards
+ * @param outputDirectory where the output files are written, mirroring the sub-directories
+ * @param options the run options
+ * @param ledger receives the allocations of every file, null when not counting them
+ * @param stats receives the statistics of every file, null when not collecting them
+ * @return true if a file could not be parsed or crashed its worker
+ * @throw runtime_error if the directory cannot be searched or a worker cannot be started
+ */
+bool run_shards(const DirectoryOptions &directory, unsigned int shards, const std::string &outputDirectory,
+                const RunOptions &options, AllocationLedger *ledger, CorpusStats *stats) throw(std::runtime_error);
+
+#endif //PROJECT1_SHARDMODE_H_H
@@ -0,0 +1,298 @@
+/**
+ * @file ShardRunner.cpp
+ * @brief Contains the source code for the ShardRunner class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "ShardRunner.h"
+
+using namespace std;
+
+namespace fs = std::experimental::filesystem;
+
+/// Bytes each file counts as on top of its size when balancing shards, for the cost of opening and writing it
+static const unsigned long long costPerFile = 4096;
+
+ShardRunner::ShardRunner(std::vector<LoadedFile> files, unsigned int shards) :
+    failedShards(0),
+    retriedFiles(0)
+{
+    for (LoadedFile &file : files) {
+        ShardFile entry;
+        entry.path = std::move(file.path);
+        entry.relative = std::move(file.relative);
+        // a file that has gone missing is still run, so its worker reports why it cannot be read
+        error_code error;
+        uintmax_t size = fs::file_size(entry.path, error);
+        entry.bytes = error ? 0 : size;
+        entry.shard = 0;
+        manifest.push_back(std::move(entry));
+    }
+    // largest first, then each file to the lightest shard, which keeps the heaviest shard close to the average
+    std::stable_sort(manifest.begin(), manifest.end(), [](const ShardFile &a, const ShardFile &b) {
+        return a.bytes > b.bytes;
+    });
+    shardBytes.assign(std::max<size_t>(1, std::min<size_t>(shards, manifest.size())), 0);
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        auto lightest = std::min_element(shardBytes.begin(), shardBytes.end());
+        manifest[i].shard = static_cast<unsigned int>(lightest - shardBytes.begin());
+        *lightest += manifest[i].bytes + costPerFile;
+        positions[manifest[i].relative.generic_string()] = i;
+    }
+}
+
+const std::vector<ShardFile> &ShardRunner::getManifest() const {
+    return manifest;
+}
+
+unsigned int ShardRunner::getShardCount() const {
+    return static_cast<unsigned int>(shardBytes.size());
+}
+
+unsigned int ShardRunner::getFailedShards() const {
+    return failedShards;
+}
+
+size_t ShardRunner::getRetriedFiles() const {
+    return retriedFiles;
+}
+
+void ShardRunner::run(const Work &work, const Collect &collect, const Lost &lost) throw(runtime_error) {
+    vector<bool> reported(manifest.size(), false);
+    vector<vector<size_t>> batches(shardBytes.size());
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        batches[manifest[i].shard].push_back(i);
+    }
+    vector<pair<size_t, string>> unreported(runBatches(batches, getShardCount(), work, collect, reported));
+
+    // a failed shard may have died on any one of its remaining files, so give each of them a worker of its own
+    vector<bool> failed(shardBytes.size(), false);
+    retriedFiles = unreported.size();
+    batches.clear();
+    for (const pair<size_t, string> &file : unreported) {
+        failed[manifest[file.first].shard] = true;
+        batches.push_back(vector<size_t>(1, file.first));
+    }
+    failedShards = static_cast<unsigned int>(std::count(failed.begin(), failed.end(), true));
+    for (const pair<size_t, string> &file : runBatches(batches, getShardCount(), work, collect, reported)) {
+        lost(manifest[file.first], file.second);
+    }
+}
+
+#ifdef __linux__
+
+/**
+ * @brief A running worker process.
+ */
+struct ShardWorker
+{
+    /// The process
+    pid_t process;
+    /// The end of the pipe the worker reports on
+    int descriptor;
+    /// The files of the worker, as places in the manifest
+    const vector<size_t> *files;
+    /// Bytes read from the pipe that do not make up a whole report yet
+    string pending;
+};
+
+/**
+ * Writes the whole of a buffer to a descriptor.
+ * @param descriptor the descriptor
+ * @param data the buffer
+ * @return true if it was all written
+ */
+static bool writeFully(int descriptor, const string &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = write(descriptor, data.data() + written, data.size() - written);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+/**
+ * Describes how a worker process ended.
+ * @param status the status from waitpid
+ * @return the description, empty if the worker exited normally
+ */
+static string describeExit(int status) {
+    if (WIFSIGNALED(status)) {
+        return "killed by signal " + to_string(WTERMSIG(status)) + " (" + strsignal(WTERMSIG(status)) + ")";
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+        return "exited with status " + to_string(WEXITSTATUS(status));
+    }
+    return string();
+}
+
+std::vector<std::pair<size_t, std::string>> ShardRunner::runBatches(const std::vector<std::vector<size_t>> &batches,
+                                                                    unsigned int concurrent, const Work &work,
+                                                                    const Collect &collect,
+                                                                    std::vector<bool> &reported)
+    throw(runtime_error) {
+    vector<pair<size_t, string>> unreported;
+    vector<ShardWorker> running;
+    size_t nextBatch = 0;
+    while (nextBatch < batches.size() || !running.empty()) {
+        while (nextBatch < batches.size() && running.size() < concurrent) {
+            const vector<size_t> &batch = batches[nextBatch++];
+            int ends[2];
+            if (pipe(ends) != 0) {
+                throw runtime_error(string("Cannot start worker: ") + strerror(errno));
+            }
+            // anything still buffered would otherwise be written again by the worker
+            cout.flush();
+            fflush(stdout);
+            pid_t process = fork();
+            if (process < 0) {
+                close(ends[0]);
+                close(ends[1]);
+                throw runtime_error(string("Cannot start worker: ") + strerror(errno));
+            }
+            if (process == 0) {
+                close(ends[0]);
+                for (const ShardWorker &worker : running) {
+                    close(worker.descriptor);
+                }
+                vector<LoadedFile> files;
+                for (size_t position : batch) {
+                    LoadedFile file;
+                    file.path = manifest[position].path;
+                    file.relative = manifest[position].relative;
+                    file.bytes = 0;
+                    files.push_back(std::move(file));
+                }
+                // each report goes straight into the pipe, so everything reported survives a crash on a later file
+                int descriptor = ends[1];
+                Report report = [descriptor](const fs::path &relative, const string &record) {
+                    string path(relative.generic_string());
+                    string frame(to_string(path.size()) + " " + to_string(record.size()) + "\n" + path + record);
+                    if (!writeFully(descriptor, frame)) {
+                        _exit(3);
+                    }
+                };
+                int code = 0;
+                try {
+                    work(std::move(files), report);
+                }
+                catch (exception &e) {
+                    cout << "Caught Exception: " << e.what() << endl;
+                    code = 1;
+                }
+                cout.flush();
+                fflush(stdout);
+                // skip the destructors and exit handlers of the state copied from the parent
+                _exit(code);
+            }
+            close(ends[1]);
+            ShardWorker worker;
+            worker.process = process;
+            worker.descriptor = ends[0];
+            worker.files = &batch;
+            running.push_back(std::move(worker));
+        }
+
+        vector<pollfd> waiting(running.size());
+        for (size_t i = 0; i < running.size(); ++i) {
+            waiting[i].fd = running[i].descriptor;
+            waiting[i].events = POLLIN;
+            waiting[i].revents = 0;
+        }
+        if (poll(waiting.data(), waiting.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Cannot wait for workers: ") + strerror(errno));
+        }
+
+        vector<ShardWorker> stillRunning;
+        for (size_t i = 0; i < running.size(); ++i) {
+            ShardWorker &worker = running[i];
+            ssize_t count = 0;
+            if (waiting[i].revents != 0) {
+                char buffer[65536];
+                count = read(worker.descriptor, buffer, sizeof(buffer));
+                if (count > 0) {
+                    worker.pending.append(buffer, static_cast<size_t>(count));
+                }
+            }
+            // hand over every complete report: "<path length> <record length>\n<path><record>"
+            size_t start = 0;
+            while (true) {
+                size_t header = worker.pending.find('\n', start);
+                if (header == string::npos) {
+                    break;
+                }
+                size_t pathLength = 0;
+                size_t recordLength = 0;
+                if (sscanf(worker.pending.c_str() + start, "%zu %zu", &pathLength, &recordLength) != 2
+                    || worker.pending.size() - header - 1 < pathLength + recordLength) {
+                    break;
+                }
+                string path(worker.pending, header + 1, pathLength);
+                auto position = positions.find(path);
+                if (position != positions.end() && !reported[position->second]) {
+                    reported[position->second] = true;
+                    collect(manifest[position->second], worker.pending.substr(header + 1 + pathLength,
+                                                                              recordLength));
+                }
+                start = header + 1 + pathLength + recordLength;
+            }
+            worker.pending.erase(0, start);
+
+            if (waiting[i].revents == 0 || count > 0 || (count < 0 && errno == EINTR)) {
+                stillRunning.push_back(std::move(worker));
+                continue;
+            }
+            // end of the pipe: the worker has exited or closed it, so collect its status
+            close(worker.descriptor);
+            int status = 0;
+            while (waitpid(worker.process, &status, 0) < 0 && errno == EINTR) {
+            }
+            string failure(describeExit(status));
+            for (size_t position : *worker.files) {
+                if (!reported[position]) {
+                    unreported.push_back(make_pair(position, failure.empty() ? "exited without finishing"
+                                                                             : failure));
+                }
+            }
+        }
+        running.swap(stillRunning);
+    }
+    return unreported;
+}
+
+#else
+
+std::vector<std::pair<size_t, std::string>> ShardRunner::runBatches(const std::vector<std::vector<size_t>> &batches,
+                                                                    unsigned int concurrent, const Work &work,
+                                                                    const Collect &collect,
+                                                                    std::vector<bool> &reported)
+    throw(runtime_error) {
+    throw runtime_error("--shards is only supported on Linux");
+}
+
+#endif
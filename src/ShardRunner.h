@@ -0,0 +1,138 @@
+/**
+ * @file ShardRunner.h
+ * @brief Contains the ShardRunner class definition, which parses a list of files in separate worker processes.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_SHARDRUNNER_H_H
+#define PROJECT1_SHARDRUNNER_H_H
+
+#pragma once
+
+#ifdef _WIN32
+#include <experimental\filesystem>
+#elif __linux__
+#include <experimental/filesystem>
+#endif
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FileLoader.h"
+
+/**
+ * @brief An entry of the manifest: a file and the shard it was given to.
+ */
+struct ShardFile
+{
+    /// The path of the file
+    std::experimental::filesystem::path path;
+    /// The path relative to the directory that was searched
+    std::experimental::filesystem::path relative;
+    /// The size of the file in bytes, 0 if it could not be found
+    unsigned long long bytes;
+    /// The shard the file belongs to
+    unsigned int shard;
+};
+
+/**
+ * @brief Splits files into shards of about the same size and works through each shard in a worker process of its
+ * own, so that a crash on one file cannot take the rest of the run with it.
+ * @details The manifest lists the files largest first, and each file goes to the shard with the fewest bytes so far,
+ * counting a fixed cost per file so that many tiny files are spread out too. Workers are forked, so they start with
+ * a copy of everything the caller has set up and must be forked before the caller starts any threads of its own.
+ *
+ * A worker reports each file the moment it is finished, with a record of the caller's choosing which is passed
+ * back to the caller in this process. When a worker dies or fails, each file it had not reported is run again in a
+ * worker of its own, at most as many at once as there are shards; a file whose own worker fails too is reported as
+ * lost along with why. Workers are only available on Linux.
+ */
+class ShardRunner
+{
+public:
+    /// Given to the work in a worker process; reports that the file with this relative path is finished
+    typedef std::function<void(const std::experimental::filesystem::path &relative, const std::string &record)>
+        Report;
+    /// Runs in a worker process over the files of its shard, which have not been read, reporting each one
+    typedef std::function<void(std::vector<LoadedFile> files, const Report &report)> Work;
+    /// Runs in this process with the record of each file a worker reported
+    typedef std::function<void(const ShardFile &file, const std::string &record)> Collect;
+    /// Runs in this process for each file that was never reported, with why its last worker failed
+    typedef std::function<void(const ShardFile &file, const std::string &reason)> Lost;
+
+private:
+    /// The files, largest first
+    std::vector<ShardFile> manifest;
+    /// The bytes given to each shard, counting the cost per file
+    std::vector<unsigned long long> shardBytes;
+    /// Maps the generic relative path of each file to its place in manifest
+    std::map<std::string, size_t> positions;
+    /// Number of shards whose worker failed before reporting every file
+    unsigned int failedShards;
+    /// Number of files retried in a worker of their own
+    size_t retriedFiles;
+
+    /**
+     * Runs each batch of files in a worker process of its own.
+     * @param batches the files of each worker, as places in manifest
+     * @param concurrent the most workers to run at once
+     * @param work what each worker runs
+     * @param collect receives each record
+     * @param reported marks each file whose record has arrived
+     * @return the files of failed workers which were not reported, each with why its worker failed
+     * @throw runtime_error if a worker cannot be started
+     */
+    std::vector<std::pair<size_t, std::string>> runBatches(const std::vector<std::vector<size_t>> &batches,
+                                                           unsigned int concurrent, const Work &work,
+                                                           const Collect &collect, std::vector<bool> &reported)
+        throw(std::runtime_error);
+
+public:
+
+    /**
+     * ShardRunner Constructor, builds the manifest.
+     * @param files the files to run; only path and relative are used
+     * @param shards the number of shards, reduced to the number of files if there are fewer
+     * @return A ShardRunner object
+     */
+    ShardRunner(std::vector<LoadedFile> files, unsigned int shards);
+
+    /**
+     * Runs every shard in a worker process and waits for them all, retrying the files of failed workers one by one.
+     * collect and lost are called on this thread, in the order records arrive.
+     * @param work what each worker runs
+     * @param collect receives the record of each file reported
+     * @param lost receives each file that was never reported
+     * @throw runtime_error if a worker cannot be started or the platform cannot fork
+     */
+    void run(const Work &work, const Collect &collect, const Lost &lost) throw(std::runtime_error);
+
+    /**
+     * Gets the manifest.
+     * @return the files, largest first, with their shards
+     */
+    const std::vector<ShardFile> &getManifest() const;
+
+    /**
+     * Gets the number of shards.
+     * @return the count
+     */
+    unsigned int getShardCount() const;
+
+    /**
+     * Gets the number of shards whose worker failed before reporting every file during run.
+     * @return the count
+     */
+    unsigned int getFailedShards() const;
+
+    /**
+     * Gets the number of files run again in a worker of their own during run.
+     * @return the count
+     */
+    size_t getRetriedFiles() const;
+};
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file SpscRing.h
+ * @brief Contains the definition and source code for the SpscRing class, a lock-free single producer, single
+ * consumer queue.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_SPSCRING_H_H
+#define PROJECT1_SPSCRING_H_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A bounded ring buffer that one thread pushes into and one other thread pops from without locking.
+ * @details The producer only writes tail and the consumer only writes head, so each index is owned by one thread and
+ * the other thread only reads it. The two indexes are kept on separate cache lines so the threads do not keep
+ * invalidating each other's line.
+ */
+template<typename T>
+class SpscRing
+{
+private:
+    /// Storage for the queued values, its size is a power of two
+    std::vector<T> slots;
+    /// slots.size() - 1, used to wrap the ever increasing indexes
+    size_t mask;
+    /// Index of the next value to pop, written by the consumer only
+    std::atomic<size_t> head;
+    /// Keeps head and tail on different cache lines without needing over-aligned allocation
+    char padding[64];
+    /// Index of the next slot to push into, written by the producer only
+    std::atomic<size_t> tail;
+
+public:
+
+    /**
+     * SpscRing Constructor
+     * @param capacity the minimum number of values the ring can hold, rounded up to a power of two
+     * @return An empty SpscRing
+     */
+    explicit SpscRing(size_t capacity) :
+        head(0),
+        tail(0)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * Moves a value into the ring. Must only be called by the producer thread.
+     * @param value the value, left moved-from on success
+     * @return true if the value was queued, false if the ring is full
+     */
+    bool tryPush(T &value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[position & mask] = std::move(value);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Moves the oldest value out of the ring. Must only be called by the consumer thread.
+     * @param value receives the value
+     * @return true if a value was popped, false if the ring is empty
+     */
+    bool tryPop(T &value)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots[position & mask]);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif
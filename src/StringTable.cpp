@@ -0,0 +1,81 @@
+/**
+ * @file StringTable.cpp
+ * @brief Contains the source code for the StringTable class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <functional>
+
+#include "StringTable.h"
+
+using namespace std;
+
+StringTable::StringTable() :
+    requests(0),
+    distinct(0),
+    entryBytes(0),
+    copyBytes(0)
+{
+}
+
+/**
+ * Gets the bytes a std::string takes, counting the block it owns when its text does not fit inline.
+ * @param capacity the capacity of the string
+ * @return the byte count
+ */
+static unsigned long long stringBytes(size_t capacity) {
+    unsigned long long bytes = sizeof(string);
+    if (capacity > string().capacity()) {
+        bytes += capacity + 1;
+    }
+    return bytes;
+}
+
+const std::string &StringTable::intern(const std::string &text) {
+    requests.fetch_add(1, memory_order_relaxed);
+    // a copy made from text would only allocate as much as text is long
+    copyBytes.fetch_add(stringBytes(text.length()), memory_order_relaxed);
+
+    Shard &shard = shards[hash<string>()(text) & (shardCount - 1)];
+    lock_guard<mutex> guard(shard.lock);
+
+    auto inserted = shard.strings.insert(text);
+    if (inserted.second) {
+        distinct.fetch_add(1, memory_order_relaxed);
+        // a node holds the next pointer and the cached hash as well as the string
+        entryBytes.fetch_add(2 * sizeof(void *) + stringBytes(inserted.first->capacity()), memory_order_relaxed);
+    }
+    return *inserted.first;
+}
+
+unsigned long long StringTable::getRequests() const {
+    return requests.load();
+}
+
+unsigned long long StringTable::getDistinct() const {
+    return distinct.load();
+}
+
+double StringTable::getDedupRatio() const {
+    unsigned long long stored = distinct.load();
+    return stored == 0 ? 1.0 : static_cast<double>(requests.load()) / stored;
+}
+
+unsigned long long StringTable::getMemoryBytes() {
+    unsigned long long bytes = entryBytes.load();
+    for (Shard &shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        bytes += shard.strings.bucket_count() * sizeof(void *);
+    }
+    return bytes;
+}
+
+unsigned long long StringTable::getCopyBytes() const {
+    return copyBytes.load();
+}
+
+long long StringTable::getSavedBytes() {
+    unsigned long long pointers = requests.load() * sizeof(const string *);
+    return static_cast<long long>(copyBytes.load()) - static_cast<long long>(pointers + getMemoryBytes());
+}
@@ -0,0 +1,106 @@
+/**
+ * @file StringTable.h
+ * @brief Contains the StringTable class definition, a thread safe intern table for the texts of parsed widgets.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_STRINGTABLE_H_H
+#define PROJECT1_STRINGTABLE_H_H
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+/**
+ * @brief Stores each distinct string once and hands out a reference to the stored copy.
+ * @details One table is shared by every parser in a run, whose descriptors point at the stored strings instead of
+ * keeping copies. The table is split into shards selected by the string hash, each with its own lock, so parsers on
+ * different threads rarely contend. Two strings from the same table are equal exactly when their addresses are
+ * equal. Strings are never removed, so a table should only live as long as one run over a set of files.
+ */
+class StringTable
+{
+private:
+    /// The number of shards
+    static const unsigned int shardCount = 16;
+
+    /**
+     * @brief One independently locked part of the table.
+     */
+    struct Shard
+    {
+        /// Guards strings
+        std::mutex lock;
+        /// The stored strings; a node never moves, so references to them stay valid
+        std::unordered_set<std::string> strings;
+    };
+
+    /// The shards
+    Shard shards[shardCount];
+    /// Number of calls to intern
+    std::atomic<unsigned long long> requests;
+    /// Number of distinct strings stored
+    std::atomic<unsigned long long> distinct;
+    /// Bytes held by the set nodes of the distinct strings, including their characters when not stored inline
+    std::atomic<unsigned long long> entryBytes;
+    /// Bytes a separate std::string for each call to intern would have held, characters included
+    std::atomic<unsigned long long> copyBytes;
+
+public:
+
+    /**
+     * StringTable Constructor
+     * @return An empty StringTable
+     */
+    StringTable();
+
+    /**
+     * Finds the stored copy of a string, storing the string if it has not been seen before.
+     * @param text the string to be interned
+     * @return the stored copy, valid for as long as the table
+     */
+    const std::string &intern(const std::string &text);
+
+    /**
+     * Gets the number of strings passed to intern.
+     * @return the count
+     */
+    unsigned long long getRequests() const;
+
+    /**
+     * Gets the number of distinct strings stored.
+     * @return the count
+     */
+    unsigned long long getDistinct() const;
+
+    /**
+     * Gets the ratio of interned strings to distinct strings.
+     * @return the ratio, 1 when every string was distinct or nothing was interned
+     */
+    double getDedupRatio() const;
+
+    /**
+     * Gets the memory held by the table: its set nodes and the characters they own and the hash buckets. Nodes are
+     * counted at the size of a typical hash set node, so the result is close but not exact.
+     * @return the byte count
+     */
+    unsigned long long getMemoryBytes();
+
+    /**
+     * Gets the memory a separate std::string for each interned string would have held, characters included.
+     * @return the byte count
+     */
+    unsigned long long getCopyBytes() const;
+
+    /**
+     * Gets the memory saved by holding a pointer to a stored string in place of a copy, once the table itself has
+     * been paid for.
+     * @return the byte count, negative when the strings repeat too little to pay for the table
+     */
+    long long getSavedBytes();
+};
+
+#endif
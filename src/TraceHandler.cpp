@@ -0,0 +1,68 @@
+/**
+ * @file TraceHandler.cpp
+ * @brief Contains the source code for the TraceHandler class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <iostream>
+
+#include "AllocationTracker.h"
+#include "TraceHandler.h"
+
+using namespace std;
+
+TraceHandler::TraceHandler(std::ostream &stream, bool printval) :
+    out(stream),
+    print(printval)
+{
+}
+
+void TraceHandler::writeLine(const std::string &line) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    if (print) {
+        cout << line << endl;
+    }
+    out << line << endl;
+}
+
+void TraceHandler::writeRecorded(const std::string &trace) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    if (print) {
+        cout << trace << flush;
+    }
+    out << trace << flush;
+}
+
+void TraceHandler::onError(ParseError error, const std::string &location, const std::string &diagnostic, Token token,
+                           const std::string &lexeme) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    writeLine(error == LIMIT_ERROR ? "******** Limit Exceeded!! ********"
+              : error == LEXICAL_ERROR ? "******** Lexical Error!! ********" : "******** Syntax Error!! ********");
+    writeLine("At " + location);
+    if (error != SYNTAX_ERROR && !diagnostic.empty()) {
+        writeLine(diagnostic);
+    }
+    onToken(token, lexeme);
+}
+
+void TraceHandler::onEnter(const char *production) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    if (print) {
+        cout << "Entering " << production << " Production" << endl;
+    }
+    out << "Entering " << production << " Production" << endl;
+}
+
+void TraceHandler::onExit(const char *production) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    if (print) {
+        cout << "Exiting " << production << " Production" << endl;
+    }
+    out << "Exiting " << production << " Production" << endl;
+}
+
+void TraceHandler::onToken(Token token, const std::string &lexeme) {
+    AllocationScope outputScope(OUTPUT_PHASE);
+    writeLine("Next Token is: " + std::to_string(token) + "; Next Lexeme is: " + lexeme);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file TraceHandler.h
+ * @brief Contains the TraceHandler class definition, which writes the text trace of a parse.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_TRACEHANDLER_H_H
+#define PROJECT1_TRACEHANDLER_H_H
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "ParseHandler.h"
+
+/**
+ * @brief Writes the OUTPUT_ trace of a parse: each production entered and left, each lexeme accepted and the error
+ * a failed file stops at.
+ */
+class TraceHandler : public ParseHandler
+{
+private:
+    /// Where the trace is written
+    std::ostream &out;
+    /// true to print the trace to the screen too
+    bool print;
+
+    /**
+     * Writes one line of the trace.
+     * @param line the line
+     */
+    void writeLine(const std::string &line);
+
+public:
+
+    /**
+     * TraceHandler Constructor
+     * @param stream where the trace is written
+     * @param printval true to print the trace to the screen too
+     * @return A TraceHandler object
+     */
+    TraceHandler(std::ostream &stream, bool printval);
+
+    /**
+     * Writes a block of trace recorded elsewhere, such as a Panel parsed on another thread.
+     * @param trace the lines, each ending in a line break
+     */
+    void writeRecorded(const std::string &trace);
+
+    void onError(ParseError error, const std::string &location, const std::string &diagnostic, Token token,
+                 const std::string &lexeme);
+
+    void onEnter(const char *production);
+
+    void onExit(const char *production);
+
+    void onToken(Token token, const std::string &lexeme);
+};
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file Utf8.cpp
+ * @brief Contains the source code for the Utf8 class
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECT1_UTF8_SSE2
+#endif
+
+#include "Utf8.h"
+
+size_t Utf8::asciiPrefix(const char *data, size_t length) {
+    size_t i = 0;
+#ifdef PROJECT1_UTF8_SSE2
+    // movemask gathers the top bit of every byte, so a zero mask means 16 ASCII bytes
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        if (_mm_movemask_epi8(block) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    while (i < length && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+unsigned int Utf8::sequenceLength(const char *data, size_t available) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    unsigned char lead = bytes[0];
+    // the lead byte fixes the length and narrows the range of the second byte to rule out overlong forms,
+    // surrogates and code points above U+10FFFF
+    unsigned int length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead < 0x80) {
+        return 1;
+    }
+    else if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) {
+            low = 0xA0;
+        }
+        else if (lead == 0xED) {
+            high = 0x9F;
+        }
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) {
+            low = 0x90;
+        }
+        else if (lead == 0xF4) {
+            high = 0x8F;
+        }
+    }
+    else {
+        return 0;
+    }
+    if (available < length || bytes[1] < low || bytes[1] > high) {
+        return 0;
+    }
+    for (unsigned int i = 2; i < length; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+size_t Utf8::validate(const char *data, size_t length, bool &ascii) {
+    ascii = true;
+    size_t i = 0;
+    while (true) {
+        i += asciiPrefix(data + i, length - i);
+        if (i == length) {
+            return length;
+        }
+        ascii = false;
+        // stay on the byte loop until the next ASCII byte, non-ASCII text tends to come in runs
+        while (i < length && static_cast<unsigned char>(data[i]) >= 0x80) {
+            unsigned int sequence = sequenceLength(data + i, length - i);
+            if (sequence == 0) {
+                return i;
+            }
+            i += sequence;
+        }
+    }
+}
+
+size_t Utf8::countCharacters(const char *begin, const char *end) {
+    size_t count = 0;
+    for (const char *p = begin; p < end; ++p) {
+        // every character has exactly one byte which is not a continuation byte
+        count += (static_cast<unsigned char>(*p) & 0xC0) != 0x80;
+    }
+    return count;
+}
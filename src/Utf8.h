@@ -0,0 +1,58 @@
+/**
+ * @file Utf8.h
+ * @brief Contains the Utf8 class definition, which validates and measures UTF-8 text.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_UTF8_H_H
+#define PROJECT1_UTF8_H_H
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Helpers for UTF-8 input.
+ * @details Valid UTF-8 is as defined by Unicode: no overlong forms, no surrogates and nothing above U+10FFFF.
+ */
+class Utf8
+{
+public:
+
+    /**
+     * Finds how many bytes at the start of a buffer are ASCII, 16 bytes at a time where SSE2 is available and 8 at a
+     * time otherwise.
+     * @param data the buffer
+     * @param length the length of the buffer
+     * @return the offset of the first byte above 0x7F, or length
+     */
+    static size_t asciiPrefix(const char *data, size_t length);
+
+    /**
+     * Measures the character starting at data.
+     * @param data the first byte of the character
+     * @param available the number of bytes from data to the end of the buffer
+     * @return the number of bytes in the character, 0 if they are not valid UTF-8
+     */
+    static unsigned int sequenceLength(const char *data, size_t available);
+
+    /**
+     * Checks that a buffer is valid UTF-8. Runs of ASCII are skipped with asciiPrefix, so plain ASCII input costs
+     * little more than reading it once.
+     * @param data the buffer
+     * @param length the length of the buffer
+     * @param ascii set to true if every byte is ASCII
+     * @return the offset of the first byte which is not part of a valid character, or length
+     */
+    static size_t validate(const char *data, size_t length, bool &ascii);
+
+    /**
+     * Counts the characters in valid UTF-8 text.
+     * @param begin the first byte
+     * @param end one past the last byte
+     * @return the number of characters
+     */
+    static size_t countCharacters(const char *begin, const char *end);
+};
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file WatchMode.cpp
+ * @brief Contains the source code for the --watch mode of the driver
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+#include "DirectoryWatcher.h"
+#include "FileLoader.h"
+#include "WatchMode.h"
+
+using namespace std;
+
+void run_watch(const string &watchDirectory, const string &outputDirectory, const DirectoryOptions &directory,
+               bool print, const RunOptions &options) throw(runtime_error) {
+    DirectoryWatcher watcher(watchDirectory, 50);
+    cout << "Watching " << watchDirectory << " for changes" << endl;
+    for (const string &problem : watcher.takeProblems()) {
+        cout << problem << endl;
+    }
+    // files are parsed one at a time here, so nothing else prints while a parse holds the lock
+    mutex consoleLock;
+    while (true) {
+        for (const std::experimental::filesystem::path &relative : watcher.wait()) {
+            if (!FileLoader::selects(relative, directory.includes, directory.excludes)) {
+                continue;
+            }
+            std::experimental::filesystem::path input(std::experimental::filesystem::path(watchDirectory) / relative);
+            std::experimental::filesystem::path outfile(output_path_for(outputDirectory, relative));
+            auto start = chrono::steady_clock::now();
+            bool valid = false;
+            string error;
+            try {
+                if (relative.has_parent_path()) {
+                    experimental::filesystem::create_directories(outfile.parent_path());
+                }
+                // the parser interns into a table of its own: a shared one would grow with every save for as long as
+                // the watch runs
+                Parser parser(input, outfile.string(), print, nullptr, options.limits.maxBytes);
+                valid = run_parser(parser, input, options, consoleLock);
+                error = parser.getLimitDiagnostic();
+            }
+            catch (runtime_error &e) {
+                error = e.what();
+            }
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            cout << (valid ? "PASS " : "FAIL ") << relative.generic_string() << " " << fixed << setprecision(3)
+                << elapsed.count() << " ms";
+            if (!error.empty()) {
+                cout << " (" << error << ")";
+            }
+            cout << endl;
+        }
+        for (const string &problem : watcher.takeProblems()) {
+            cout << problem << endl;
+        }
+    }
+}
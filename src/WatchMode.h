@@ -0,0 +1,30 @@
+/**
+ * @file WatchMode.h
+ * @brief Contains the --watch mode of the driver, which re-parses each file below a directory as soon as it is saved.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+#ifndef PROJECT1_WATCHMODE_H_H
+#define PROJECT1_WATCHMODE_H_H
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "ParseRun.h"
+
+/**
+ * Watches a directory and re-parses each selected file below it when it is saved, printing one PASS or FAIL line per
+ * file. Runs until the process is stopped.
+ * @param watchDirectory the directory to watch
+ * @param outputDirectory where the output files are written, mirroring the sub-directories
+ * @param directory the globs selecting the files to parse; the rest of it is not used
+ * @param print print the output of each parse to the screen too
+ * @param options the run options
+ * @throw runtime_error if the directory cannot be watched
+ */
+void run_watch(const std::string &watchDirectory, const std::string &outputDirectory,
+               const DirectoryOptions &directory, bool print, const RunOptions &options) throw(std::runtime_error);
+
+#endif //PROJECT1_WATCHMODE_H_H
@@ -34,7 +34,7 @@
  * Under Dialect select ISO c++1y(-std=c++1y)
  *
  * go to Project Properties -> c/c++ Build -> settings -> Tool Settings -> GCC C++ Linker\n
- * Under Libraries add stdc++fs
+ * Under Libraries add stdc++fs and pthread
  *
  * \subsection MINGW32
  * There are bugs in the MINGW32 compiler that mishandle c++11 functionality such as std::stoi or std::to_string.
@@ -55,24 +55,107 @@
     Optional Options:\n
         -h,--help                       Show this help message.\n
         -d,--directory DIRECTORY        Specify Path holding files to test. Cannot use with --file.\n
+                                        Sub-directories are searched too.\n
                                         (Defaults to ..\\test_input_files\\ / ../test_input_files/)\n
         -o,--output DIRECTORY           Specify Directory for output files.\n
                                         (Defaults to ..\\test_input_files\\ / ../test_input_files/)\n
         -f,--file FILE                  Use to Parse only a single file. Cannot use with --directory\n
         -p,--print                      Print output to screen.\n
+        -i,--include GLOB               Only parse files in --directory whose name matches GLOB. May be repeated.\n
+                                        A GLOB containing '/' is matched against the path below the directory.\n
+        -x,--exclude GLOB               Skip files in --directory matching GLOB. May be repeated.\n
+                                        Output files (OUTPUT_*) are always skipped.\n
+        -r,--readers N                  Number of threads reading files ahead of the parsers. (Defaults to 4)\n
+        --prefetch N                    Most files read ahead and waiting for a parser. (Defaults to 16)\n
+        -j,--jobs N                     Number of files parsed at once. (Defaults to 1, always 1 with --print)\n
+        --shards N                      Split the files of --directory into N shards of about the same size and\n
+                                        parse each shard in a process of its own, one file at a time, so a crash\n
+                                        only loses the file it happened on. The files a crashed shard had not\n
+                                        finished are retried in a process each. Linux only; cannot be used with\n
+                                        --print or --index.\n
+        -w,--watch DIRECTORY            Keep running and re-parse each file below DIRECTORY as soon as it is saved,\n
+                                        printing one PASS or FAIL line per file. --include and --exclude apply.\n
+                                        Output files are written beside the inputs unless --output is given.\n
+        -m,--memory                     Count the heap allocations made by the lexer, the parser and output\n
+                                        for each file and report them with the summary. Needs a build\n
+                                        configured with -DPARSER_TRACK_ALLOCATIONS=ON.\n
+        -s,--stats                      Report widget counts, Panel nesting depths, layouts, grid sizes and\n
+                                        percentiles of text length, file size and parse time over --directory.\n
+        -g,--generate DIRECTORY         Write a constexpr C++ header for each valid file into DIRECTORY.\n
+                                        Headers are only rewritten when their contents change.\n
+        -l,--lex-threads N              Lex each file up front using N threads. Produces the same tokens as\n
+                                        the default serial lexer. A file is only split once it is at least\n
+                                        two chunks long, so files under 128 KB are lexed on one thread\n
+                                        unless --lex-chunk is lowered.\n
+        --lex-chunk N                   Give each thread lexing a file up front at least N bytes.\n
+                                        (Defaults to 65536)\n
+        -P,--pipeline                   Lex on a separate thread that stays ahead of the parser.\n
+                                        Ignored when --lex-threads is given.\n
+        -T,--panel-threads N            Parse separate Panels of each file on N threads after lexing it up\n
+                                        front. Produces the same output as the sequential parser; meant for\n
+                                        very large files.\n
+        --max-bytes N                   Stop any file larger than N bytes. (Defaults to no limit)\n
+        --max-tokens N                  Stop any file after N lexemes. (Defaults to no limit)\n
+        --max-depth N                   Stop any file nesting Panels and Groups more than N deep, counting the\n
+                                        Window. (Defaults to 1000)\n
+        --max-string N                  Stop any file with a lexeme longer than N bytes, such as a quoted\n
+                                        string left open to the end of the file. (Defaults to no limit)\n
+        --max-time-ms N                 Stop any file still being parsed after N milliseconds.\n
+                                        (Defaults to no limit)\n
+                                        A stopped file gets a Limit Exceeded error and the run carries on.\n
+        -b,--benchmark                  Time serial and parallel lexing of --file at 1, 2, 4, ... threads\n
+                                        up to --lex-threads or the number of cores, with chunks of at\n
+                                        least --lex-chunk bytes, then time parsing --file with synchronous\n
+                                        and pipelined lexing.\n
+        -F,--format                     Rewrite --file, or every file in --directory, in the canonical layout.\n
+                                        --include and --exclude apply. Nothing is parsed.\n
+        -c,--check                      Like --format but only report the files that are not in the canonical\n
+                                        layout. Exits with 1 if there are any.\n
+        --index FILE                    Write an index of the widgets, texts and layout numbers of every valid\n
+                                        file in --directory to FILE, for use with query.\n\n
+
+    Commands:\n
+        query INDEX CLAUSE...           Print the files in INDEX matching every CLAUSE without parsing again.\n
+                                        A CLAUSE is a kind (Button, Grid, ...), a kind and its text\n
+                                        (Button=Delete, or text=Delete for any kind), or a comparison of a\n
+                                        number such as grid.columns>8. The numbers are window.width,\n
+                                        window.height, textfield.width, grid.rows, grid.columns, grid.hgap,\n
+                                        grid.vgap, border.hgap and border.vgap.\n
+        diff OLD NEW                    Parse two versions of a file and print the widgets added, removed or\n
+                                        changed, with their paths. Exits with 1 if there are any.\n
  *
  */
 #include <algorithm>
+#include <atomic>
 
 #ifdef _WIN32
 #include <experimental\filesystem>
 #elif __linux__
 #include <experimental/filesystem>
 #endif
+#include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <vector>
 
+#include "AllocationTracker.h"
+#include "Benchmark.h"
+#include "CorpusIndex.h"
+#include "CorpusStats.h"
+#include "DiffCommand.h"
+#include "FileLoader.h"
+#include "FormatMode.h"
+#include "ParseRun.h"
 #include "Parser.h"
+#include "QueryCommand.h"
+#include "ShardMode.h"
+#include "StringTable.h"
+#include "WatchMode.h"
 #include "stringhelper.h"
 
 using namespace std;
@@ -86,10 +169,71 @@ static void show_usage(string name) {
     cerr << "Usage: " << name << " <option(s)>\n" << description
         << "Optional Options:\n"
         << "\t-h,--help\t\t\tShow this help message.\n"
-        << "\t-d,--directory DIRECTORY\tSpecify Path holding files to test. Cannot use with --file.\n\t\t\t\t\t(Defaults to ..\\test_input_files\\ / ../test_input_files/)\n"
+        << "\t-d,--directory DIRECTORY\tSpecify Path holding files to test. Cannot use with --file.\n\t\t\t\t\tSub-directories are searched too.\n\t\t\t\t\t(Defaults to ..\\test_input_files\\ / ../test_input_files/)\n"
         << "\t-o,--output DIRECTORY\t\tSpecify Directory for output files.\n\t\t\t\t\t(Defaults to ..\\test_input_files\\ / ../test_input_files/)\n"
         << "\t-f,--file FILE\t\t\tUse to Parse only a single file. Cannot use with --directory\n"
-        << "\t-p,--print\t\t\tPrint output to screen.\n" << endl;
+        << "\t-p,--print\t\t\tPrint output to screen.\n"
+        << "\t-i,--include GLOB\t\tOnly parse files in --directory whose name matches GLOB. May be repeated.\n"
+        << "\t\t\t\t\tA GLOB containing '/' is matched against the path below the directory.\n"
+        << "\t-x,--exclude GLOB\t\tSkip files in --directory matching GLOB. May be repeated.\n"
+        << "\t\t\t\t\tOutput files (OUTPUT_*) are always skipped.\n"
+        << "\t-r,--readers N\t\t\tNumber of threads reading files ahead of the parsers. (Defaults to 4)\n"
+        << "\t--prefetch N\t\t\tMost files read ahead and waiting for a parser. (Defaults to 16)\n"
+        << "\t-j,--jobs N\t\t\tNumber of files parsed at once. (Defaults to 1, always 1 with --print)\n"
+        << "\t--shards N\t\t\tSplit the files of --directory into N shards of about the same size and\n"
+        << "\t\t\t\t\tparse each shard in a process of its own, one file at a time, so a crash\n"
+        << "\t\t\t\t\tonly loses the file it happened on. The files a crashed shard had not\n"
+        << "\t\t\t\t\tfinished are retried in a process each. Linux only; cannot be used with\n"
+        << "\t\t\t\t\t--print or --index.\n"
+        << "\t-w,--watch DIRECTORY\t\tKeep running and re-parse each file below DIRECTORY as soon as it is saved,\n"
+        << "\t\t\t\t\tprinting one PASS or FAIL line per file. --include and --exclude apply.\n"
+        << "\t\t\t\t\tOutput files are written beside the inputs unless --output is given.\n"
+        << "\t-m,--memory\t\t\tCount the heap allocations made by the lexer, the parser and output\n"
+        << "\t\t\t\t\tfor each file and report them with the summary. Needs a build\n"
+        << "\t\t\t\t\tconfigured with -DPARSER_TRACK_ALLOCATIONS=ON.\n"
+        << "\t-s,--stats\t\t\tReport widget counts, Panel nesting depths, layouts, grid sizes and\n"
+        << "\t\t\t\t\tpercentiles of text length, file size and parse time over --directory.\n"
+        << "\t-g,--generate DIRECTORY\t\tWrite a constexpr C++ header for each valid file into DIRECTORY.\n"
+        << "\t\t\t\t\tHeaders are only rewritten when their contents change.\n"
+        << "\t-l,--lex-threads N\t\tLex each file up front using N threads. Produces the same tokens as\n"
+        << "\t\t\t\t\tthe default serial lexer. A file is only split once it is at least\n"
+        << "\t\t\t\t\ttwo chunks long, so files under 128 KB are lexed on one thread\n"
+        << "\t\t\t\t\tunless --lex-chunk is lowered.\n"
+        << "\t--lex-chunk N\t\t\tGive each thread lexing a file up front at least N bytes.\n"
+        << "\t\t\t\t\t(Defaults to 65536)\n"
+        << "\t-P,--pipeline\t\t\tLex on a separate thread that stays ahead of the parser.\n"
+        << "\t\t\t\t\tIgnored when --lex-threads is given.\n"
+        << "\t-T,--panel-threads N\t\tParse separate Panels of each file on N threads after lexing it up\n"
+        << "\t\t\t\t\tfront. Produces the same output as the sequential parser; meant for\n"
+        << "\t\t\t\t\tvery large files.\n"
+        << "\t--max-bytes N\t\t\tStop any file larger than N bytes. (Defaults to no limit)\n"
+        << "\t--max-tokens N\t\t\tStop any file after N lexemes. (Defaults to no limit)\n"
+        << "\t--max-depth N\t\t\tStop any file nesting Panels and Groups more than N deep, counting the\n"
+        << "\t\t\t\t\tWindow. (Defaults to 1000)\n"
+        << "\t--max-string N\t\t\tStop any file with a lexeme longer than N bytes, such as a quoted\n"
+        << "\t\t\t\t\tstring left open to the end of the file. (Defaults to no limit)\n"
+        << "\t--max-time-ms N\t\t\tStop any file still being parsed after N milliseconds.\n"
+        << "\t\t\t\t\t(Defaults to no limit)\n"
+        << "\t\t\t\t\tA stopped file gets a Limit Exceeded error and the run carries on.\n"
+        << "\t-b,--benchmark\t\t\tTime serial and parallel lexing of --file at 1, 2, 4, ... threads\n"
+        << "\t\t\t\t\tup to --lex-threads or the number of cores, with chunks of at\n"
+        << "\t\t\t\t\tleast --lex-chunk bytes, then time parsing --file with synchronous\n"
+        << "\t\t\t\t\tand pipelined lexing.\n"
+        << "\t-F,--format\t\t\tRewrite --file, or every file in --directory, in the canonical layout.\n"
+        << "\t\t\t\t\t--include and --exclude apply. Nothing is parsed.\n"
+        << "\t-c,--check\t\t\tLike --format but only report the files that are not in the canonical\n"
+        << "\t\t\t\t\tlayout. Exits with 1 if there are any.\n"
+        << "\t--index FILE\t\t\tWrite an index of the widgets, texts and layout numbers of every valid\n"
+        << "\t\t\t\t\tfile in --directory to FILE, for use with query.\n\n"
+        << "Commands:\n"
+        << "\tquery INDEX CLAUSE...\t\tPrint the files in INDEX matching every CLAUSE without parsing again.\n"
+        << "\t\t\t\t\tA CLAUSE is a kind (Button, Grid, ...), a kind and its text\n"
+        << "\t\t\t\t\t(Button=Delete, or text=Delete for any kind), or a comparison of a\n"
+        << "\t\t\t\t\tnumber such as grid.columns>8. The numbers are window.width,\n"
+        << "\t\t\t\t\twindow.height, textfield.width, grid.rows, grid.columns, grid.hgap,\n"
+        << "\t\t\t\t\tgrid.vgap, border.hgap and border.vgap.\n"
+        << "\tdiff OLD NEW\t\t\tParse two versions of a file and print the widgets added, removed or\n"
+        << "\t\t\t\t\tchanged, with their paths. Exits with 1 if there are any.\n" << endl;
 }
 
 /**
@@ -99,13 +243,15 @@ static void show_usage(string name) {
  * @return an int
  */
 int main(int argc, char *argv[]) {
-    if (argc > 7) {
-        show_usage(argv[0]);
-        exit(1);
-    }
     if (argc == 1){
         cout << "Use the -h option for more details" << endl;
     }
+    if (argc > 1 && string(argv[1]) == "query") {
+        return run_query(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "diff") {
+        return run_diff(argc, argv);
+    }
 #ifdef _WIN32
     std::string testDirectory("..\\test_input_files");
     set<char> delimiters{ '\\' };
@@ -117,10 +263,35 @@ int main(int argc, char *argv[]) {
     // default output location
     string outputDirectory(testDirectory);
     string singleFileName("");
+    string generateDirectory("");
     
     bool directoryCheck = false;
     bool fileCheck = false;
     bool printCheck = false;
+    bool generateCheck = false;
+    bool benchmarkCheck = false;
+    bool pipelineCheck = false;
+    unsigned int lexThreads = 0;
+    unsigned int lexChunk = Lexer::defaultChunk;
+    unsigned int panelThreads = 0;
+    unsigned int readers = 4;
+    unsigned int prefetch = 16;
+    unsigned int jobs = 1;
+    unsigned int shards = 0;
+    ParseLimits limits = ParseLimits::defaults();
+    bool memoryCheck = false;
+    bool statsCheck = false;
+    bool outputCheck = false;
+    bool watchCheck = false;
+    string watchDirectory("");
+    string indexFile("");
+    bool formatCheck = false;
+    bool checkOnly = false;
+    vector<string> includes;
+    vector<string> excludes;
+
+    // the texts of every widget tree are interned once across every file in the run
+    StringTable strings;
 
     // Handle Options
     for (int i = 0; i < argc; ++i) {
@@ -144,6 +315,7 @@ int main(int argc, char *argv[]) {
             }
         }
         else if (arg == "-o" || arg == "--output") {
+            outputCheck = true;
             if (i + 1 < argc) {
                 outputDirectory = argv[++i];
             }
@@ -169,6 +341,202 @@ int main(int argc, char *argv[]) {
         else if (arg == "-p" || arg == "--print") {
             printCheck = true;
         }
+        else if (arg == "-l" || arg == "--lex-threads") {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                lexThreads = static_cast<unsigned int>(atoi(argv[++i]));
+            }
+            else {
+                cout << "--lex-threads requires a positive number" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "--lex-chunk") {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                lexChunk = static_cast<unsigned int>(atoi(argv[++i]));
+            }
+            else {
+                cout << "--lex-chunk requires a positive number" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-T" || arg == "--panel-threads") {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                panelThreads = static_cast<unsigned int>(atoi(argv[++i]));
+            }
+            else {
+                cout << "--panel-threads requires a positive number" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-i" || arg == "--include" || arg == "-x" || arg == "--exclude") {
+            if (i + 1 < argc) {
+                (arg == "-i" || arg == "--include" ? includes : excludes).push_back(argv[++i]);
+            }
+            else {
+                cout << arg << " requires one argument" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-r" || arg == "--readers" || arg == "--prefetch" || arg == "-j" || arg == "--jobs"
+                 || arg == "--shards") {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                unsigned int value = static_cast<unsigned int>(atoi(argv[++i]));
+                (arg == "-r" || arg == "--readers" ? readers : arg == "--prefetch" ? prefetch
+                    : arg == "--shards" ? shards : jobs) = value;
+            }
+            else {
+                cout << arg << " requires a positive number" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "--max-bytes" || arg == "--max-tokens" || arg == "--max-depth" || arg == "--max-string"
+                 || arg == "--max-time-ms") {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                unsigned int value = static_cast<unsigned int>(atoi(argv[++i]));
+                (arg == "--max-bytes" ? limits.maxBytes : arg == "--max-tokens" ? limits.maxTokens
+                    : arg == "--max-depth" ? limits.maxDepth : arg == "--max-string" ? limits.maxString
+                    : limits.maxMilliseconds) = value;
+            }
+            else {
+                cout << arg << " requires a positive number" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-w" || arg == "--watch") {
+            watchCheck = true;
+            if (i + 1 < argc) {
+                watchDirectory = argv[++i];
+            }
+            else {
+                cout << "--watch requires one argument" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-F" || arg == "--format") {
+            formatCheck = true;
+        }
+        else if (arg == "-c" || arg == "--check") {
+            formatCheck = true;
+            checkOnly = true;
+        }
+        else if (arg == "--index") {
+            if (i + 1 < argc) {
+                indexFile = argv[++i];
+            }
+            else {
+                cout << "--index requires one argument" << endl;
+                exit(1);
+            }
+        }
+        else if (arg == "-m" || arg == "--memory") {
+            if (!AllocationScope::isTracking()) {
+                cout << "--memory requires a build configured with -DPARSER_TRACK_ALLOCATIONS=ON" << endl;
+                exit(1);
+            }
+            memoryCheck = true;
+        }
+        else if (arg == "-s" || arg == "--stats") {
+            statsCheck = true;
+        }
+        else if (arg == "-P" || arg == "--pipeline") {
+            pipelineCheck = true;
+        }
+        else if (arg == "-b" || arg == "--benchmark") {
+            benchmarkCheck = true;
+        }
+        else if (arg == "-g" || arg == "--generate") {
+            generateCheck = true;
+            if (i + 1 < argc) {
+                generateDirectory = argv[++i];
+            }
+            else {
+                cout << "--generate requires one argument" << endl;
+                exit(1);
+            }
+        }
+    }
+
+    RunOptions options;
+    options.generate = generateCheck;
+    options.generateDirectory = generateDirectory;
+    options.lexThreads = lexThreads;
+    options.lexChunk = lexChunk;
+    options.pipeline = pipelineCheck;
+    options.panelThreads = panelThreads;
+    options.limits = limits;
+    DirectoryOptions directory;
+    directory.directory = testDirectory;
+    directory.includes = includes;
+    directory.excludes = excludes;
+    // output files are never inputs, whatever else is excluded; --watch would otherwise re-parse its own output
+    directory.excludes.push_back("OUTPUT_*");
+    directory.readers = readers;
+    directory.prefetch = prefetch;
+    directory.jobs = jobs;
+
+    // allocations of each file are charged to a ledger, and every ledger is added into this one
+    AllocationLedger runLedger;
+    // the statistics of every thread in a directory run are added into this one at the end
+    CorpusStats stats;
+    // set when a file of a sharded run could not be parsed or crashed its worker
+    bool shardFailed = false;
+
+    if (!indexFile.empty() && (fileCheck || watchCheck)) {
+        cout << "--index cannot be used with --file or --watch" << endl;
+        exit(1);
+    }
+    if (statsCheck && (fileCheck || watchCheck)) {
+        cout << "--stats cannot be used with --file or --watch" << endl;
+        exit(1);
+    }
+    if (shards && (fileCheck || watchCheck || printCheck || !indexFile.empty())) {
+        cout << "--shards cannot be used with --file, --watch, --print or --index" << endl;
+        exit(1);
+    }
+
+    if (formatCheck) {
+        try {
+            return run_format(fileCheck ? singleFileName : string(), directory, limits, checkOnly);
+        }
+        catch (runtime_error &e) {
+            cout << "Caught Exception: " << e.what() << endl;
+            exit(1);
+        }
+    }
+
+    if (benchmarkCheck) {
+        if (!fileCheck) {
+            cout << "--benchmark requires --file" << endl;
+            exit(1);
+        }
+        try {
+            run_lexer_benchmark(singleFileName, lexThreads ? lexThreads : std::max(1u, thread::hardware_concurrency()),
+                                lexChunk);
+            vector <string> pathSplit = StringHelper::splitpath(singleFileName, delimiters);
+#ifdef _WIN32
+            run_parser_benchmark(singleFileName, outputDirectory + "\\OUTPUT_" + pathSplit.back());
+#elif __linux__
+            run_parser_benchmark(singleFileName, outputDirectory + "/OUTPUT_" + pathSplit.back());
+#endif
+        }
+        catch (runtime_error& e) {
+            cout << "Caught Exception: " << e.what() << endl;
+            exit(1);
+        }
+        return 0;
+    }
+
+    if (watchCheck) {
+        if (!outputCheck) {
+            outputDirectory = watchDirectory;
+        }
+        try {
+            run_watch(watchDirectory, outputDirectory, directory, printCheck, options);
+        }
+        catch (runtime_error &e) {
+            cout << "Caught Exception: " << e.what() << endl;
+            exit(1);
+        }
     }
 
     // if we only want one file
@@ -185,42 +553,115 @@ int main(int argc, char *argv[]) {
                 << "\n*******************************************************\n\n\n" << endl;;
         }
         try {
-
-            Parser parser(std::experimental::filesystem::path(singleFileName), outfile, printCheck);
-            parser.file();
+            // read the file the way a directory run does, before any allocations are counted, so that --memory
+            // reports the same numbers for it either way
+            LoadedFile file;
+            file.path = singleFileName;
+            file.relative = pathSplit.back();
+            file.bytes = 0;
+            {
+                FileLoader loader(vector<LoadedFile>(1, file), 1, 1, limits.maxBytes);
+                loader.next(file);
+            }
+            if (!file.error.empty()) {
+                throw runtime_error(file.error);
+            }
+            AllocationScope fileScope(memoryCheck ? &runLedger : nullptr, PARSE_PHASE);
+            Parser parser(file.path, std::move(file.contents), outfile, printCheck, &strings, file.bytes);
+            mutex consoleLock;
+            run_parser(parser, file.path, options, consoleLock);
+            if (!parser.getLimitDiagnostic().empty()) {
+                cout << "Stopped " << singleFileName << ": " << parser.getLimitDiagnostic() << endl;
+            }
         }
         catch (runtime_error& e) {
             cout << "Caught Exception: " << e.what() << endl;
             exit(1);
         }
     }
+    else if (shards) {
+        // the same run as below, with each shard of the files parsed in a process of its own
+        try {
+            shardFailed = run_shards(directory, shards, outputDirectory, options, memoryCheck ? &runLedger : nullptr,
+                                     statsCheck ? &stats : nullptr);
+        }
+        catch (runtime_error &e) {
+            cout << "Caught Exception: " << e.what() << endl;
+            exit(1);
+        }
+    }
     else {
-        // grab all files in the input directory
-        for (auto& dirEntry : experimental::filesystem::directory_iterator(testDirectory)) {
-            vector <string> pathSplit = StringHelper::splitpath(dirEntry.path().string(), delimiters);
-            if (!pathSplit.back().find("OUTPUT_"))
-                continue;
-#ifdef _WIN32
-            string outfile(outputDirectory + "\\OUTPUT_" + pathSplit.back());
-#elif __linux__
-            string outfile(outputDirectory + "/OUTPUT_" + pathSplit.back());
-#endif
-            if (printCheck) {
-                cout << "\n\n*******************************************************\nPARSING: "
-                    << dirEntry
-                    << "\n*******************************************************\n\n\n" << endl;;
+        // grab all matching files below the input directory, reading them ahead of the parsers
+        if (printCheck) {
+            directory.jobs = 1;
+        }
+        CorpusIndexBuilder index;
+        try {
+            FileLoader loader(directory.directory, directory.includes, directory.excludes, directory.readers,
+                              directory.prefetch, limits.maxBytes);
+            atomic<bool> failed(false);
+            mutex consoleLock;
+            auto work = [&]() {
+                LoadedFile file;
+                // each thread counts on its own and is added to stats once it runs out of files
+                CorpusStats threadStats;
+                while (!failed && loader.next(file)) {
+                    try {
+                        AllocationLedger ledger;
+                        parse_loaded_file(file, outputDirectory, options, printCheck, strings,
+                                          memoryCheck ? &ledger : nullptr, statsCheck ? &threadStats : nullptr,
+                                          indexFile.empty() ? nullptr : &index, consoleLock);
+                        if (memoryCheck) {
+                            lock_guard<mutex> guard(consoleLock);
+                            write_allocations(file.relative.generic_string(), ledger);
+                            runLedger.merge(ledger);
+                        }
+                    }
+                    catch (runtime_error &e) {
+                        lock_guard<mutex> guard(consoleLock);
+                        cout << "Caught Exception: " << e.what() << endl;
+                        failed = true;
+                    }
+                }
+                if (statsCheck) {
+                    lock_guard<mutex> guard(consoleLock);
+                    stats.merge(threadStats);
+                }
+            };
+            vector<thread> workers;
+            for (unsigned int i = 1; i < directory.jobs; ++i) {
+                workers.emplace_back(work);
             }
-            try {
-                Parser parser(dirEntry.path(), outfile, printCheck);
-                parser.file();
+            work();
+            for (thread &worker : workers) {
+                worker.join();
             }
-            catch (runtime_error &e) {
-                cout << "Caught Exception: " << e.what() << endl;
+            if (failed) {
                 exit(1);
             }
-            
+            if (!indexFile.empty()) {
+                size_t terms = index.write(indexFile);
+                cout << "Indexed " << index.size() << " of " << loader.size() << " files, " << terms << " terms, into "
+                    << indexFile << endl;
+            }
+        }
+        catch (runtime_error &e) {
+            cout << "Caught Exception: " << e.what() << endl;
+            exit(1);
         }
     }
+    // a sharded run has already reported the strings of its workers' tables
+    if (!shards) {
+        cout << "Strings: " << strings.getRequests() << " interned, " << strings.getDistinct() << " distinct ("
+            << strings.getDedupRatio() << "x dedup), " << strings.getMemoryBytes() << " bytes held by the table, "
+            << strings.getSavedBytes() << " bytes saved over a copy per widget" << endl;
+    }
+    if (memoryCheck) {
+        write_allocations("all files", runLedger);
+    }
+    if (statsCheck) {
+        stats.write(cout);
+    }
     cout << "... Finished\nCheck " << outputDirectory << " for all output files."<< endl;
-    return 0;
+    return shardFailed ? 1 : 0;
 }
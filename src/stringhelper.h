@@ -104,6 +104,47 @@ public:
 
         return result;
     }
+
+    /**
+     * Matches a string against a glob pattern where '*' matches any run of characters and '?' matches any one
+     * character.
+     * @param pattern the glob
+     * @param text the string to be matched
+     * @return true if the whole string matches
+     */
+    static bool globMatch(const std::string &pattern, const std::string &text)
+    {
+        size_t p = 0, t = 0;
+        size_t star = std::string::npos, retry = 0;
+        while (t < text.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+            {
+                ++p;
+                ++t;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star = p++;
+                retry = t;
+            }
+            else if (star != std::string::npos)
+            {
+                // let the last '*' swallow one more character and try again
+                p = star + 1;
+                t = ++retry;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            ++p;
+        }
+        return p == pattern.size();
+    }
 };
 
 #endif
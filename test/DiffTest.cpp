@@ -0,0 +1,134 @@
+/**
+ * @file DiffTest.cpp
+ * @brief Checks what the diff command prints and the exit code it returns for changed, equal and unparsable files.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DiffCommand.h"
+
+using namespace std;
+
+/**
+ * Writes a file.
+ * @param fileName the file
+ * @param contents what to write
+ * @throw runtime_error if the file cannot be written
+ */
+static void writeFile(const string &fileName, const string &contents) throw(runtime_error) {
+    ofstream out(fileName, ios::binary);
+    out << contents;
+    if (!out) {
+        throw runtime_error("Cannot write " + fileName);
+    }
+}
+
+/**
+ * Runs the diff command and checks what it printed, leaving out the time taken, and its exit code.
+ * @param name what is being compared, for the report
+ * @param files the files given to the command
+ * @param expected the output expected, the time taken left out
+ * @param expectedCode the exit code expected
+ * @return 1 if the output or the exit code differs, 0 otherwise
+ */
+static int check(const string &name, const vector<string> &files, const string &expected, int expectedCode) {
+    vector<string> arguments = { "parser", "diff" };
+    arguments.insert(arguments.end(), files.begin(), files.end());
+    vector<char *> argv;
+    for (string &argument : arguments) {
+        argv.push_back(&argument[0]);
+    }
+
+    ostringstream printed;
+    streambuf *console = cout.rdbuf(printed.rdbuf());
+    int code = run_diff(static_cast<int>(argv.size()), argv.data());
+    cout.rdbuf(console);
+
+    string output(printed.str());
+    size_t time = output.rfind(" in ");
+    if (output.find(" differences found in ") != string::npos && time != string::npos) {
+        output.erase(time, output.find('\n', time) - time);
+    }
+    if (output != expected || code != expectedCode) {
+        cout << name << ": exit code " << code << ", expected " << expectedCode << ", printed\n" << output
+            << "expected\n" << expected;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Compares versions of a file differing in texts, numbers, layouts and children, and files which cannot be compared.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for the versions compared
+ * @return 0 if every comparison prints and returns what it should, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    string inputs(argv[1]);
+    string oldFile(string(argv[2]) + "/diff_old.txt");
+    string newFile(string(argv[2]) + "/diff_new.txt");
+    int failures = 0;
+    try {
+        writeFile(oldFile, "Window \"W\" (10, 20) Layout Flow():\n"
+                           "  Button \"a\";\n"
+                           "  Label \"b\";\n"
+                           "  Panel Layout Grid(1, 2):\n"
+                           "    Button \"c\";\n"
+                           "    Textfield 3;\n"
+                           "  End;\n"
+                           "End.\n");
+        writeFile(newFile, "Window \"W\" (10, 20) Layout Flow():\n"
+                           "  Button \"a\";\n"
+                           "  Label \"x\";\n"
+                           "  Panel Layout Grid(1, 3):\n"
+                           "    Button \"c\";\n"
+                           "    Label \"r\";\n"
+                           "  End;\n"
+                           "  Button \"n\";\n"
+                           "End.\n");
+    }
+    catch (runtime_error &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+
+    failures += check("changed", { oldFile, newFile },
+                      "changed Window/Label[2]: Label \"b\" -> Label \"x\"\n"
+                      "changed Window/Panel[3]: Panel Grid(1, 2) -> Panel Grid(1, 3)\n"
+                      "removed Window/Panel[3]/Textfield[2]: Textfield 3\n"
+                      "added   Window/Panel[3]/Label[2]: Label \"r\"\n"
+                      "added   Window/Button[4]: Button \"n\"\n"
+                      "5 differences found\n", 1);
+    failures += check("changed back", { newFile, oldFile },
+                      "changed Window/Label[2]: Label \"x\" -> Label \"b\"\n"
+                      "changed Window/Panel[3]: Panel Grid(1, 3) -> Panel Grid(1, 2)\n"
+                      "removed Window/Panel[3]/Label[2]: Label \"r\"\n"
+                      "added   Window/Panel[3]/Textfield[2]: Textfield 3\n"
+                      "removed Window/Button[4]: Button \"n\"\n"
+                      "5 differences found\n", 1);
+    failures += check("input3 to input4", { inputs + "/input3.txt", inputs + "/input4.txt" },
+                      "changed Window: Window \"Calculator\" (200, 200) Flow(CENTER) -> "
+                      "Window \"Calculator\" (200, 200) Border()\n"
+                      "added   Window/Label[2]: Label \"-------------------\"\n"
+                      "changed Window/Panel[3]: Panel Grid(4, 3) -> Panel Grid(4, 3, 5, 5)\n"
+                      "added   Window/Panel[3]/Label[12]: Label \"-------------------\"\n"
+                      "4 differences found\n", 1);
+    failures += check("same", { oldFile, oldFile }, "0 differences found\n", 0);
+    failures += check("unparsable", { oldFile, inputs + "/input1.txt" },
+                      "Caught Exception: " + inputs + "/input1.txt does not parse\n", 2);
+    failures += check("missing", { inputs + "/missing.txt", oldFile },
+                      "Caught Exception: Invalid path to input file " + inputs + "/missing.txt\n", 2);
+    failures += check("one file", { oldFile }, "diff requires an old and a new file\n", 2);
+    cout << "diff: " << (failures ? "FAIL" : "PASS") << endl;
+    return failures ? 1 : 0;
+}
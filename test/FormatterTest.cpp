@@ -0,0 +1,134 @@
+/**
+ * @file FormatterTest.cpp
+ * @brief Checks that formatting a formatted file changes nothing, and that a file is only formatted when the result
+ * lexes to the same tokens.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Formatter.h"
+
+using namespace std;
+
+/**
+ * Lists the tokens and lexemes of a text, up to the first invalid one.
+ * @param text the text
+ * @return the tokens and lexemes, one per line
+ */
+static string lexemes(const string &text) {
+    Lexer lexer(string("lexemes"), text);
+    string listed;
+    LexedToken token(lexer.getStartToken());
+    while (lexer.scanNext(token) && token.settled && token.token != NONE) {
+        listed += to_string(token.token) + " " + token.lexeme + "\n";
+    }
+    return listed;
+}
+
+/**
+ * Formats a text, then formats the result, which must succeed without changing it and lex to the same tokens as the
+ * original text.
+ * @param name what the text is, for the report
+ * @param text the text
+ * @param formatted set to whether the text could be formatted at all
+ * @return 1 if formatting is not idempotent, 0 otherwise
+ */
+static int check(const string &name, const string &text, bool &formatted) {
+    Formatter once(string("once"), text);
+    formatted = once.format();
+    if (!formatted) {
+        return 0;
+    }
+    Formatter twice(string("twice"), once.getFormatted());
+    if (!twice.format()) {
+        cout << name << ": the formatted text cannot be formatted again: " << twice.getError() << endl;
+        return 1;
+    }
+    if (twice.isChanged()) {
+        cout << name << ": formatting the formatted text changes it" << endl;
+        return 1;
+    }
+    if (lexemes(once.getFormatted()) != lexemes(text)) {
+        cout << name << ": the formatted text lexes differently" << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Checks the sample inputs, texts ending in every way the lexer can finish a file and random runs of lexemes and
+ * separators.
+ * @param argc number of arguments
+ * @param argv the directory holding the sample inputs
+ * @return 0 if formatting is always idempotent, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    int failures = 0;
+    bool formatted = false;
+    for (int i = 1; i <= 6; ++i) {
+        string name("input" + to_string(i));
+        ifstream in(string(argv[1]) + "/" + name + ".txt", ios::binary);
+        if (!in.is_open()) {
+            cout << "Cannot read " << name << endl;
+            return 1;
+        }
+        string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        int fileFailures = check(name, text, formatted);
+        // every sample but the one with an invalid lexeme is formatted
+        if (formatted != (i != 1)) {
+            cout << name << ": " << (formatted ? "formatted" : "not formatted") << endl;
+            ++fileFailures;
+        }
+        cout << name << ": " << (fileFailures ? "FAIL" : "PASS") << endl;
+        failures += fileFailures;
+    }
+
+    // a number is only finished by the character after it, so whatever follows it at the end must not matter
+    int endingFailures = 0;
+    for (const string text : { "Window12", "Window12 ", "Window12\n", "Window12 \r\n ", "Window 12 ", "12 ",
+                               "Window\"a\"12 ", "Window \"a\" (1, 2", "Window \"a\" (1, 2) ", "End. ", "(",
+                               "Window \"a\"", "Window \"a\" " }) {
+        endingFailures += check("\"" + text + "\"", text, formatted);
+        bool refused = text.find_last_of("0123456789") != string::npos
+            && text.find_last_not_of(" \r\n") == text.find_last_of("0123456789");
+        if (refused == formatted) {
+            cout << "\"" << text << "\": " << (formatted ? "formatted" : "not formatted") << endl;
+            ++endingFailures;
+        }
+    }
+    cout << "endings: " << (endingFailures ? "FAIL" : "PASS") << endl;
+    failures += endingFailures;
+
+    // pieces which run into each other differently depending on what separates them
+    const vector<string> pieces = { "Window", "Panel", "Group", "Button", "Label", "Textfield", "Radio", "Layout",
+                                    "Flow", "Grid", "Border", "LEFT", "CENTER", "End", "\"a b\"", "\"\"", "12",
+                                    "0", "2147483647", "(", ")", ",", ";", ":", ".", "Window12" };
+    const vector<string> separators = { "", " ", "  ", "\n", "\r\n", "\t" };
+    mt19937 random(330);
+    int randomFailures = 0;
+    unsigned int randomFormatted = 0;
+    for (unsigned int i = 0; i < 20000; ++i) {
+        string text;
+        unsigned int length = 1 + random() % 12;
+        for (unsigned int piece = 0; piece < length; ++piece) {
+            text += pieces[random() % pieces.size()] + separators[random() % separators.size()];
+        }
+        randomFailures += check("\"" + text + "\"", text, formatted);
+        randomFormatted += formatted;
+    }
+    cout << "random texts: " << (randomFailures ? "FAIL" : "PASS") << " (" << randomFormatted
+        << " of 20000 formatted)" << endl;
+    failures += randomFailures;
+    return failures ? 1 : 0;
+}
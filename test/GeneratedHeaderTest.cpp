@@ -0,0 +1,131 @@
+/**
+ * @file GeneratedHeaderTest.cpp
+ * @brief Checks that the headers generated from the sample inputs hold the same widget tree the parser records.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <iostream>
+#include <string>
+
+#include "Parser.h"
+
+#include "input3.h"
+#include "input4.h"
+#include "input5.h"
+#include "input6.h"
+
+using namespace std;
+
+/**
+ * Maps a token to the position of the matching enumerator in a generated Kind, which lists None, the widgets, the
+ * layouts and the alignments in that order.
+ * @param token the token
+ * @return the position
+ */
+static int kindPosition(Token token) {
+    switch (token) {
+        case WINDOW: return 1;
+        case PANEL: return 2;
+        case GROUP: return 3;
+        case BUTTON: return 4;
+        case LABEL: return 5;
+        case TEXTFIELD: return 6;
+        case RADIO: return 7;
+        case FLOW: return 8;
+        case BORDER: return 9;
+        case GRID: return 10;
+        case LEFT: return 11;
+        case RIGHT: return 12;
+        case CENTER: return 13;
+        default: return 0;
+    }
+}
+
+/**
+ * Compares the data of one generated header with a fresh parse of the file it was generated from.
+ * @param name the name of the input, e.g. input3
+ * @param nodes the generated nodes
+ * @param nodeCount the number of generated nodes
+ * @param strings the generated strings
+ * @param stringCount the number of generated strings
+ * @param inputDirectory the directory holding the input
+ * @param outputDirectory where the parser may write its output
+ * @return the number of differences found
+ */
+template <typename Node>
+static int check(const string &name, const Node *nodes, unsigned int nodeCount, const char *const *strings,
+                 unsigned int stringCount, const string &inputDirectory, const string &outputDirectory) {
+    Parser parser(inputDirectory + "/" + name + ".txt", outputDirectory + "/OUTPUT_" + name + ".txt", false, nullptr);
+    if (!parser.file()) {
+        cout << name << ": does not parse" << endl;
+        return 1;
+    }
+    const vector<DescriptorNode> &expected = parser.getDescriptor().getNodes();
+    if (expected.size() != nodeCount) {
+        cout << name << ": " << nodeCount << " nodes generated, " << expected.size() << " parsed" << endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (unsigned int i = 0; i < nodeCount; ++i) {
+        const Node &node = nodes[i];
+        const DescriptorNode &parsed = expected[i];
+        bool same = static_cast<int>(node.kind) == kindPosition(parsed.kind)
+            && static_cast<int>(node.layout) == kindPosition(parsed.layout)
+            && static_cast<int>(node.align) == kindPosition(parsed.align)
+            && node.parent == parsed.parent && node.end == parsed.end
+            && node.numberCount == parsed.numbers.size() && node.layoutParamCount == parsed.layoutParams.size();
+        for (size_t n = 0; same && n < parsed.numbers.size(); ++n) {
+            same = node.numbers[n] == parsed.numbers[n];
+        }
+        for (size_t p = 0; same && p < parsed.layoutParams.size(); ++p) {
+            same = node.layoutParams[p] == parsed.layoutParams[p];
+        }
+        bool hasText = parsed.kind == WINDOW || parsed.kind == BUTTON || parsed.kind == LABEL || parsed.kind == RADIO;
+        if (same && hasText) {
+            same = node.text >= 0 && static_cast<unsigned int>(node.text) < stringCount
+                && *parsed.text == strings[node.text];
+        }
+        else if (same) {
+            same = node.text == -1;
+        }
+        if (!same) {
+            cout << name << ": node " << i << " differs from the parse" << endl;
+            ++failures;
+        }
+    }
+    cout << name << ": " << nodeCount << " nodes, " << (failures ? "FAIL" : "PASS") << endl;
+    return failures;
+}
+
+/**
+ * Runs the check for every generated header.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for parser output
+ * @return 0 if every header matches its parse, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    int failures = 0;
+    try {
+        failures += check("input3", input3::nodes, input3::nodeCount, input3::strings, input3::stringCount, argv[1],
+                          argv[2]);
+        failures += check("input4", input4::nodes, input4::nodeCount, input4::strings, input4::stringCount, argv[1],
+                          argv[2]);
+        failures += check("input5", input5::nodes, input5::nodeCount, input5::strings, input5::stringCount, argv[1],
+                          argv[2]);
+        failures += check("input6", input6::nodes, input6::nodeCount, input6::strings, input6::stringCount, argv[1],
+                          argv[2]);
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    // the tree is usable in constant expressions, which is the point of generating it
+    static_assert(input3::nodes[0].kind == input3::Kind::Window, "the first node is the Window");
+    return failures ? 1 : 0;
+}
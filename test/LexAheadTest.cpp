@@ -0,0 +1,167 @@
+/**
+ * @file LexAheadTest.cpp
+ * @brief Checks that lexing up front on several threads hands out the same lexemes as lexing on demand, wherever the
+ * chunk boundaries fall.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Lexer.h"
+
+using namespace std;
+
+/**
+ * @brief What getNextToken handed out for one lexeme.
+ */
+struct Handed
+{
+    /// The token
+    Token token;
+    /// The lexeme
+    string lexeme;
+    /// Where the lexeme starts
+    unsigned int offset;
+    /// The value of a NUMBER
+    int number;
+    /// Why the lexeme is invalid
+    string diagnostic;
+};
+
+/**
+ * Hands out a number of lexemes from a lexer.
+ * @param lexer the lexer
+ * @param count how many lexemes to hand out
+ * @return the lexemes
+ */
+static vector<Handed> handOut(Lexer &lexer, size_t count) {
+    vector<Handed> handed;
+    for (size_t i = 0; i < count; ++i) {
+        Handed lexeme;
+        lexeme.token = lexer.getNextToken();
+        lexeme.lexeme = lexer.getCurrentLexeme();
+        lexeme.offset = lexer.getCurrentOffset();
+        lexeme.diagnostic = lexer.getDiagnostic();
+        // the value is only read back once the next lexeme has been handed out
+        lexeme.number = 0;
+        if (i > 0 && handed.back().token == NUMBER) {
+            handed.back().number = lexer.getPreviousNumber();
+        }
+        handed.push_back(lexeme);
+    }
+    return handed;
+}
+
+/**
+ * Counts the lexemes the serial lexer hands out for a text, up to and including the first one found at its end or
+ * one that does not advance, after which every lexeme repeats.
+ * @param text the text
+ * @return the count
+ */
+static size_t countLexemes(const string &text) {
+    Lexer lexer(string("serial"), text);
+    size_t count = 0;
+    unsigned int previous = 0;
+    while (true) {
+        Token token = lexer.getNextToken();
+        ++count;
+        unsigned int offset = lexer.getCurrentOffset();
+        if (offset >= text.length() || (count > 1 && token == NONE && offset == previous)) {
+            return count;
+        }
+        previous = offset;
+    }
+}
+
+/**
+ * Lexes a text up front with every thread count and chunk size given and compares the lexemes handed out with those
+ * of the serial lexer, a few past the end of the text included.
+ * @param name what the text is, for the report
+ * @param text the text
+ * @param threadCounts the thread counts to try
+ * @param chunkSizes the chunk sizes to try
+ * @return the number of runs which differ
+ */
+static int check(const string &name, const string &text, const vector<unsigned int> &threadCounts,
+                 const vector<unsigned int> &chunkSizes) {
+    size_t count = countLexemes(text) + 2;
+    Lexer serial(string("serial"), text);
+    vector<Handed> expected(handOut(serial, count));
+    int failures = 0;
+    for (unsigned int threads : threadCounts) {
+        for (unsigned int chunk : chunkSizes) {
+            Lexer ahead(string("ahead"), text);
+            ahead.lexAhead(threads, chunk);
+            vector<Handed> actual(handOut(ahead, count));
+            for (size_t i = 0; i < count; ++i) {
+                const Handed &a = actual[i];
+                const Handed &e = expected[i];
+                if (a.token != e.token || a.lexeme != e.lexeme || a.offset != e.offset || a.number != e.number
+                    || a.diagnostic != e.diagnostic) {
+                    cout << name << ": " << threads << " threads, chunks of " << chunk << " bytes: lexeme " << i
+                        << " is \"" << a.lexeme << "\" at " << a.offset << ", expected \"" << e.lexeme << "\" at "
+                        << e.offset << endl;
+                    ++failures;
+                    break;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * Runs the check on the sample inputs and on texts built so that boundaries fall inside quoted strings and numbers.
+ * @param argc number of arguments
+ * @param argv the directory holding the sample inputs
+ * @return 0 if every run matches the serial lexer, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    vector<unsigned int> threadCounts = { 2, 3, 4, 7 };
+    vector<unsigned int> smallChunks;
+    for (unsigned int chunk = 1; chunk <= 16; ++chunk) {
+        smallChunks.push_back(chunk);
+    }
+
+    int failures = 0;
+    for (int i = 1; i <= 6; ++i) {
+        string name("input" + to_string(i));
+        ifstream in(string(argv[1]) + "/" + name + ".txt", ios::binary);
+        if (!in.is_open()) {
+            cout << "Cannot read " << name << endl;
+            return 1;
+        }
+        string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        int fileFailures = check(name, text, threadCounts, smallChunks);
+        cout << name << ": " << (fileFailures ? "FAIL" : "PASS") << endl;
+        failures += fileFailures;
+    }
+
+    // quoted strings holding spaces, punctuation and multibyte characters, numbers of every length up to one too
+    // large for an int, a keyword run into a number, line breaks of both kinds and a quote left open at the end;
+    // padding the front moves each boundary across every byte of them
+    string body("Window \"A (b); c.\" (123, 4567) Layout Grid(2147483647, 99999999999):\r\n"
+                "  Button \"\xC3\x9C \xE6\x97\xA5\"; Label \"\";\n  Textfield 0;Window12 \"open ,: end");
+    int paddedFailures = 0;
+    for (unsigned int padding = 0; padding < 32; ++padding) {
+        paddedFailures += check("padded by " + to_string(padding), string(padding, ' ') + body, threadCounts,
+                                { 1, 2, 5 });
+    }
+    cout << "boundaries inside quotes and numbers: " << (paddedFailures ? "FAIL" : "PASS") << endl;
+    failures += paddedFailures;
+
+    // the default chunk leaves a file this small on one thread, which must give the same lexemes as well
+    int defaultFailures = check("default chunk", body, threadCounts, { Lexer::defaultChunk });
+    cout << "default chunk: " << (defaultFailures ? "FAIL" : "PASS") << endl;
+    failures += defaultFailures;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file LimitsTest.cpp
+ * @brief Checks that each per-file limit stops a file just past it with its Limit Exceeded diagnostic, and lets the
+ * file through at the limit.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "Parser.h"
+
+using namespace std;
+
+/**
+ * Reads a whole file.
+ * @param fileName the file
+ * @return the contents
+ * @throw runtime_error if the file cannot be read
+ */
+static string readFile(const string &fileName) throw(runtime_error) {
+    ifstream in(fileName, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Cannot read " + fileName);
+    }
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+/// The ways the lexer can hand lexemes to the parser
+enum LexMode
+{
+    ON_DEMAND, LEX_AHEAD, PIPELINE
+};
+
+/**
+ * Parses a text under some limits and checks whether it was stopped, and how.
+ * @param name what is being checked, for the report
+ * @param text the text
+ * @param limits the limits
+ * @param diagnostic the diagnostic expected, empty if the file must parse
+ * @param outputFile where the trace is written
+ * @return the number of lex modes in which the parse was wrong
+ * @throw runtime_error if the trace cannot be read or written
+ */
+static int check(const string &name, const string &text, const ParseLimits &limits, const string &diagnostic,
+                 const string &outputFile) throw(runtime_error) {
+    int failures = 0;
+    for (LexMode mode : { ON_DEMAND, LEX_AHEAD, PIPELINE }) {
+        bool valid;
+        string actual;
+        {
+            Parser parser(string("limits.txt"), text, outputFile, false);
+            parser.setLimits(limits);
+            if (mode == LEX_AHEAD) {
+                parser.lexAhead(4, 1);
+            }
+            else if (mode == PIPELINE) {
+                parser.pipeline();
+            }
+            valid = parser.file();
+            actual = parser.getLimitDiagnostic();
+        }
+        string trace(readFile(outputFile));
+        bool reported = trace.find("******** Limit Exceeded!! ********\n") != string::npos
+            && trace.find("\n" + diagnostic + "\n") != string::npos;
+        string modeName(mode == ON_DEMAND ? "on demand" : mode == LEX_AHEAD ? "lexed ahead" : "pipelined");
+        if (diagnostic.empty() && (!valid || !actual.empty())) {
+            cout << name << ", " << modeName << ": stopped with \"" << actual << "\"" << endl;
+            ++failures;
+        }
+        else if (!diagnostic.empty() && (valid || actual != diagnostic || !reported)) {
+            cout << name << ", " << modeName << ": " << (valid ? "valid" : "stopped with \"" + actual + "\"")
+                << (reported ? "" : ", no Limit Exceeded in the trace") << ", expected \"" << diagnostic << "\""
+                << endl;
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+/**
+ * Runs each limit one below and at what the sample inputs need, and the time limit on a file too large to parse in a
+ * millisecond.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for parser output
+ * @return 0 if every limit stops exactly the files past it, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    string outputFile(string(argv[2]) + "/OUTPUT_limits.txt");
+    int failures = 0;
+    try {
+        // input6 nests four Panels in its Window, and both have a label longer than any other lexeme
+        for (const string name : { "input4", "input6" }) {
+            string text(readFile(string(argv[1]) + "/" + name + ".txt"));
+            unsigned int lexemes = 0;
+            unsigned int longest = 0;
+            Lexer lexer(name, text);
+            while (lexer.getNextToken() != PERIOD) {
+                ++lexemes;
+                longest = std::max<unsigned int>(longest, static_cast<unsigned int>(lexer.getCurrentLexeme().length()));
+            }
+            ++lexemes;
+            unsigned int bytes = static_cast<unsigned int>(text.length());
+            unsigned int depth = name == "input4" ? 2 : 5;
+
+            int fileFailures = 0;
+            ParseLimits limits(ParseLimits::defaults());
+            limits.maxBytes = bytes - 1;
+            fileFailures += check(name + " --max-bytes", text, limits, "File is " + to_string(bytes)
+                                  + " bytes, more than the limit of " + to_string(bytes - 1), outputFile);
+            limits.maxBytes = bytes;
+            fileFailures += check(name + " --max-bytes", text, limits, "", outputFile);
+
+            limits = ParseLimits::defaults();
+            limits.maxTokens = lexemes - 1;
+            fileFailures += check(name + " --max-tokens", text, limits, "More than the limit of "
+                                  + to_string(lexemes - 1) + " lexemes", outputFile);
+            limits.maxTokens = lexemes;
+            fileFailures += check(name + " --max-tokens", text, limits, "", outputFile);
+
+            limits = ParseLimits::defaults();
+            limits.maxDepth = depth - 1;
+            fileFailures += check(name + " --max-depth", text, limits, "Nesting is deeper than the limit of "
+                                  + to_string(depth - 1), outputFile);
+            limits.maxDepth = depth;
+            fileFailures += check(name + " --max-depth", text, limits, "", outputFile);
+
+            limits = ParseLimits::defaults();
+            limits.maxString = longest - 1;
+            fileFailures += check(name + " --max-string", text, limits, "Lexeme of " + to_string(longest)
+                                  + " bytes is longer than the limit of " + to_string(longest - 1), outputFile);
+            limits.maxString = longest;
+            fileFailures += check(name + " --max-string", text, limits, "", outputFile);
+
+            cout << name << ": " << (fileFailures ? "FAIL" : "PASS") << endl;
+            failures += fileFailures;
+        }
+
+        // far more lexemes than can be lexed in a millisecond, so the deadline is always found past
+        string slow("Window \"Slow\" (1, 1) Layout Flow():\n");
+        for (unsigned int i = 0; i < 200000; ++i) {
+            slow += "  Button \"b\";\n";
+        }
+        slow += "End.\n";
+        ParseLimits limits(ParseLimits::defaults());
+        limits.maxMilliseconds = 1;
+        int timeFailures = check("--max-time-ms", slow, limits, "Took longer than the limit of 1 ms", outputFile);
+        cout << "--max-time-ms: " << (timeFailures ? "FAIL" : "PASS") << endl;
+        failures += timeFailures;
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
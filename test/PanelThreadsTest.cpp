@@ -0,0 +1,189 @@
+/**
+ * @file PanelThreadsTest.cpp
+ * @brief Checks that parsing Panels on separate threads writes the same trace and records the same widget tree as a
+ * sequential parse, errors and limits included.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Parser.h"
+
+using namespace std;
+
+/**
+ * Reads a whole file.
+ * @param fileName the file
+ * @return the contents
+ * @throw runtime_error if the file cannot be read
+ */
+static string readFile(const string &fileName) throw(runtime_error) {
+    ifstream in(fileName, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Cannot read " + fileName);
+    }
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+/**
+ * @brief What a parse left behind.
+ */
+struct Result
+{
+    /// Whether the file is valid
+    bool valid;
+    /// Why a limit stopped the file
+    string limit;
+    /// The nodes recorded, one per line
+    string nodes;
+};
+
+/**
+ * Parses a text sequentially, or with its Panels on separate threads.
+ * @param text the text
+ * @param outputFile where the trace is written
+ * @param limits the limits on the file
+ * @param strings the table the texts are interned in
+ * @param threads the threads to parse Panels on, 0 to parse sequentially
+ * @param minimumChunk the fewest bytes given to a thread lexing the file
+ * @param minimumTokens the fewest lexemes in a Panel worth handing to another thread
+ * @return what the parse left behind
+ * @throw runtime_error if the trace cannot be written
+ */
+static Result parse(const string &text, const string &outputFile, const ParseLimits &limits, StringTable &strings,
+                    unsigned int threads, unsigned int minimumChunk, size_t minimumTokens) throw(runtime_error) {
+    Parser parser(string("panels.txt"), text, outputFile, false, &strings);
+    parser.setLimits(limits);
+    if (threads > 0) {
+        parser.parallelPanels(threads, minimumChunk, minimumTokens);
+    }
+    Result result;
+    result.valid = parser.file();
+    result.limit = parser.getLimitDiagnostic();
+    for (const DescriptorNode &node : parser.getDescriptor().getNodes()) {
+        // the texts are interned in the same table, so equal texts have equal addresses
+        result.nodes += to_string(node.hash) + " " + to_string(reinterpret_cast<uintptr_t>(node.text)) + " "
+            + to_string(node.parent) + " " + to_string(node.end) + "\n";
+    }
+    return result;
+}
+
+/**
+ * Compares the parse of a text with its Panels on separate threads against the sequential parse, for every thread
+ * count and with lexing chunks and Panels small enough that every Panel of a sample is handed out.
+ * @param name what the text is, for the report
+ * @param text the text
+ * @param limits the limits on the file
+ * @param outputDirectory where the parsers may write their output
+ * @return the number of runs which differ
+ * @throw runtime_error if a trace cannot be read or written
+ */
+static int check(const string &name, const string &text, const ParseLimits &limits, const string &outputDirectory)
+    throw(runtime_error) {
+    string sequentialOutput(outputDirectory + "/OUTPUT_panels_sequential.txt");
+    string parallelOutput(outputDirectory + "/OUTPUT_panels_parallel.txt");
+    StringTable strings;
+    Result expected(parse(text, sequentialOutput, limits, strings, 0, 0, 0));
+    string expectedTrace(readFile(sequentialOutput));
+    int failures = 0;
+    for (unsigned int threads : { 1u, 2u, 4u }) {
+        for (unsigned int minimumChunk : { 1u, 16u, Lexer::defaultChunk }) {
+            for (size_t minimumTokens : { 1u, 4u, 256u }) {
+                Result actual(parse(text, parallelOutput, limits, strings, threads, minimumChunk, minimumTokens));
+                string what;
+                if (actual.valid != expected.valid) {
+                    what = actual.valid ? "is valid" : "is invalid";
+                }
+                else if (actual.limit != expected.limit) {
+                    what = "stops with \"" + actual.limit + "\"";
+                }
+                else if (actual.nodes != expected.nodes) {
+                    what = "records a different widget tree";
+                }
+                else if (readFile(parallelOutput) != expectedTrace) {
+                    what = "writes a different trace";
+                }
+                if (!what.empty()) {
+                    cout << name << ": " << threads << " threads, chunks of " << minimumChunk << " bytes, Panels of "
+                        << minimumTokens << " lexemes " << what << endl;
+                    ++failures;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * Runs the checks on the sample inputs and on nested Panels with an error or a limit in each of them.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for parser output
+ * @return 0 if parsing Panels on threads always matches, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    int failures = 0;
+    try {
+        for (int i = 1; i <= 6; ++i) {
+            string name("input" + to_string(i));
+            int fileFailures = check(name, readFile(string(argv[1]) + "/" + name + ".txt"), ParseLimits::defaults(),
+                                     argv[2]);
+            cout << name << ": " << (fileFailures ? "FAIL" : "PASS") << endl;
+            failures += fileFailures;
+        }
+
+        // sibling and nested Panels around a Group, so that some are parsed inside others and some beside them
+        string nested("Window \"Nested\" (400, 300) Layout Flow(LEFT):\n"
+                      "  Panel Layout Grid(2, 2):\n"
+                      "    Button \"a\";\n"
+                      "    Panel Layout Flow(RIGHT):\n"
+                      "      Label \"b\";\n"
+                      "      Group\n"
+                      "        Radio \"c\";\n"
+                      "        Radio \"d\";\n"
+                      "      End;\n"
+                      "    End;\n"
+                      "    Textfield 8;\n"
+                      "  End;\n"
+                      "  Panel Layout Border(1, 2):\n"
+                      "    Panel Layout Flow(CENTER):\n"
+                      "      Button \"e\";\n"
+                      "    End;\n"
+                      "  End;\n"
+                      "  Label \"f\";\n"
+                      "End.\n");
+        int nestedFailures = check("nested", nested, ParseLimits::defaults(), argv[2]);
+        // break each widget in turn, inside and outside the Panels
+        size_t breaks = 0;
+        for (size_t semicolon = nested.find(';'); semicolon != string::npos;
+             semicolon = nested.find(';', semicolon + 1)) {
+            string broken(nested);
+            broken[semicolon] = ',';
+            nestedFailures += check("nested, ',' at " + to_string(semicolon), broken, ParseLimits::defaults(),
+                                    argv[2]);
+            ++breaks;
+        }
+        // a limit on the nesting must stop the file at the same place when it is crossed inside a Panel
+        for (unsigned int depth = 1; depth <= 4; ++depth) {
+            ParseLimits limits(ParseLimits::defaults());
+            limits.maxDepth = depth;
+            nestedFailures += check("nested, at most " + to_string(depth) + " deep", nested, limits, argv[2]);
+        }
+        cout << "nested Panels, " << breaks << " errors and the depth limit: " << (nestedFailures ? "FAIL" : "PASS")
+            << endl;
+        failures += nestedFailures;
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
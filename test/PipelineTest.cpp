@@ -0,0 +1,144 @@
+/**
+ * @file PipelineTest.cpp
+ * @brief Checks that lexing on a separate thread hands the parser the same lexemes as lexing on demand.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Parser.h"
+
+using namespace std;
+
+/**
+ * Reads a whole file.
+ * @param fileName the file
+ * @return the contents
+ * @throw runtime_error if the file cannot be read
+ */
+static string readFile(const string &fileName) throw(runtime_error) {
+    ifstream in(fileName, ios::binary);
+    if (!in.is_open()) {
+        throw runtime_error("Cannot read " + fileName);
+    }
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+/**
+ * Hands out every lexeme of a text, a few past the end included, and describes each on a line of its own.
+ * @param lexer the lexer
+ * @param count how many lexemes to hand out
+ * @return the description
+ */
+static string handOut(Lexer &lexer, size_t count) {
+    string handed;
+    Token previous = NONE;
+    for (size_t i = 0; i < count; ++i) {
+        Token token = lexer.getNextToken();
+        // the value of a NUMBER is only read back once the next lexeme has been handed out
+        if (previous == NUMBER) {
+            handed += "= " + to_string(lexer.getPreviousNumber()) + "\n";
+        }
+        handed += to_string(token) + " " + to_string(lexer.getCurrentOffset()) + " " + lexer.getCurrentLexeme() + " "
+            + lexer.getDiagnostic() + "\n";
+        previous = token;
+    }
+    return handed;
+}
+
+/**
+ * Compares the lexemes of a pipelined lexer with those of the serial lexer for every batch size and ring size given,
+ * small ones included so that lexemes straddle many batches and the producer has to wait for the parser.
+ * @param name what the text is, for the report
+ * @param text the text
+ * @return the number of runs which differ
+ */
+static int checkLexemes(const string &name, const string &text) {
+    // every lexeme advances by at least a byte except the last, so this reaches well past the end
+    size_t count = text.length() + 4;
+    Lexer serial(string("serial"), text);
+    string expected(handOut(serial, count));
+    int failures = 0;
+    for (unsigned int batchSize : { 1u, 2u, 3u, 7u, 256u }) {
+        for (unsigned int batches : { 1u, 2u, 64u }) {
+            Lexer pipelined(string("pipelined"), text);
+            pipelined.pipeline(batchSize, batches);
+            if (handOut(pipelined, count) != expected) {
+                cout << name << ": batches of " << batchSize << " in a ring of " << batches
+                    << " differ from the serial lexer" << endl;
+                ++failures;
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * Parses a file with and without the pipeline and compares the output written and the widget trees recorded.
+ * @param inputFile the file
+ * @param outputDirectory where the parsers may write their output
+ * @return the number of differences found
+ * @throw runtime_error if a file cannot be read or written
+ */
+static int checkParse(const string &inputFile, const string &outputDirectory) throw(runtime_error) {
+    string serialOutput(outputDirectory + "/OUTPUT_pipeline_serial.txt");
+    string pipelinedOutput(outputDirectory + "/OUTPUT_pipeline_pipelined.txt");
+    StringTable strings;
+    Parser serial(inputFile, serialOutput, false, &strings);
+    Parser pipelined(inputFile, pipelinedOutput, false, &strings);
+    pipelined.pipeline();
+    bool serialValid = serial.file();
+    bool pipelinedValid = pipelined.file();
+
+    const vector<DescriptorNode> &expected = serial.getDescriptor().getNodes();
+    const vector<DescriptorNode> &actual = pipelined.getDescriptor().getNodes();
+    bool same = serialValid == pipelinedValid && expected.size() == actual.size();
+    for (size_t i = 0; same && i < expected.size(); ++i) {
+        same = expected[i].hash == actual[i].hash && expected[i].text == actual[i].text
+            && expected[i].parent == actual[i].parent && expected[i].end == actual[i].end;
+    }
+    if (!same) {
+        cout << inputFile << ": the pipelined parse records a different widget tree" << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Runs the checks on the sample inputs.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for parser output
+ * @return 0 if the pipeline always matches, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    int failures = 0;
+    try {
+        for (int i = 1; i <= 6; ++i) {
+            string name("input" + to_string(i));
+            string inputFile(string(argv[1]) + "/" + name + ".txt");
+            int fileFailures = checkLexemes(name, readFile(inputFile)) + checkParse(inputFile, argv[2]);
+            // the trace names every lexeme the parser was handed, so equal output means equal lexemes
+            if (readFile(string(argv[2]) + "/OUTPUT_pipeline_serial.txt")
+                != readFile(string(argv[2]) + "/OUTPUT_pipeline_pipelined.txt")) {
+                cout << name << ": the pipelined parse writes different output" << endl;
+                ++fileFailures;
+            }
+            cout << name << ": " << (fileFailures ? "FAIL" : "PASS") << endl;
+            failures += fileFailures;
+        }
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file QueryTest.cpp
+ * @brief Checks that an index of the sample inputs answers each form of query clause with the files that hold it.
+ * @author Kristopher Bickmore
+ * @date October 19, 2026
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CorpusIndex.h"
+#include "Parser.h"
+
+using namespace std;
+
+/**
+ * @brief A query and the files it must match.
+ */
+struct Case
+{
+    /// The clauses, which must all hold
+    vector<string> clauses;
+    /// The matching files, sorted
+    vector<string> expected;
+};
+
+/**
+ * Joins strings with spaces, for the report.
+ * @param parts the strings
+ * @return the joined string
+ */
+static string join(const vector<string> &parts) {
+    string joined;
+    for (const string &part : parts) {
+        joined += (joined.empty() ? "" : " ") + part;
+    }
+    return joined;
+}
+
+/**
+ * Indexes the valid sample inputs and runs every case against the index, then checks that malformed comparisons are
+ * refused.
+ * @param argc number of arguments
+ * @param argv the directory holding the inputs, then a directory for parser output and the index
+ * @return 0 if every query matches the expected files, 1 otherwise
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " INPUT_DIRECTORY OUTPUT_DIRECTORY" << endl;
+        return 1;
+    }
+    string indexFile(string(argv[2]) + "/query_test.idx");
+    int failures = 0;
+    try {
+        // the builder keeps pointers to the texts, so the table and the parsers outlive it
+        StringTable strings;
+        vector<unique_ptr<Parser>> parsers;
+        CorpusIndexBuilder builder;
+        for (const string name : { "input3", "input4", "input5", "input6" }) {
+            parsers.emplace_back(new Parser(string(argv[1]) + "/" + name + ".txt",
+                                            string(argv[2]) + "/OUTPUT_query_" + name + ".txt", false, &strings));
+            if (!parsers.back()->file()) {
+                cout << name << ": does not parse" << endl;
+                return 1;
+            }
+            builder.add(name, parsers.back()->getDescriptor());
+        }
+        builder.write(indexFile);
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+
+    const vector<Case> cases = {
+        // kinds and layouts
+        { { "Group" }, { "input5" } },
+        { { "Panel" }, { "input3", "input4", "input6" } },
+        { { "Grid" }, { "input3", "input4", "input5" } },
+        { { "Textfield" }, { "input3", "input4" } },
+        // aligned flows
+        { { "Flow=Center" }, { "input3", "input6" } },
+        { { "Flow=Left" }, { "input6" } },
+        // texts with and without their kind
+        { { "Button=7" }, { "input3", "input4" } },
+        { { "Label=Main Panel" }, { "input6" } },
+        { { "Radio=Third" }, { "input5" } },
+        { { "Button=Main Panel" }, { } },
+        { { "text=Calculator" }, { "input3", "input4" } },
+        { { "text=Main Panel" }, { "input6" } },
+        { { "text=Sixth" }, { } },
+        // each comparison
+        { { "window.width=300" }, { "input5" } },
+        { { "window.width<300" }, { "input3", "input4" } },
+        { { "window.width<=300" }, { "input3", "input4", "input5" } },
+        { { "window.width>300" }, { "input6" } },
+        { { "window.width>=200" }, { "input3", "input4", "input5", "input6" } },
+        { { "textfield.width=20" }, { "input3", "input4" } },
+        { { "grid.rows=5" }, { "input5" } },
+        { { "grid.hgap>=5" }, { "input4" } },
+        { { "border.hgap=4" }, { "input6" } },
+        { { "border.vgap>0" }, { "input6" } },
+        // every clause must hold
+        { { "Grid", "Flow=Center" }, { "input3" } },
+        { { "Button", "window.height=200", "Border" }, { "input4", "input6" } },
+        { { "Radio", "Button" }, { } },
+    };
+    try {
+        CorpusIndex index(indexFile);
+        for (const Case &test : cases) {
+            vector<string> matched(index.query(test.clauses));
+            if (matched != test.expected) {
+                cout << join(test.clauses) << ": matched \"" << join(matched) << "\", expected \""
+                    << join(test.expected) << "\"" << endl;
+                ++failures;
+            }
+        }
+        cout << "queries: " << (failures ? "FAIL" : "PASS") << endl;
+
+        int refusals = 0;
+        for (const string clause : { "window.width", "window.width=wide", "window.width=>3",
+                                     "grid.rows=99999999999" }) {
+            try {
+                index.query({ clause });
+                cout << clause << ": was not refused" << endl;
+                ++refusals;
+            }
+            catch (runtime_error &) {
+            }
+        }
+        cout << "malformed comparisons: " << (refusals ? "FAIL" : "PASS") << endl;
+        failures += refusals;
+    }
+    catch (exception &e) {
+        cout << "Caught Exception: " << e.what() << endl;
+        return 1;
+    }
+    return failures ? 1 : 0;
+}